@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <libslic3r/libslic3r.h>
+#include <libslic3r/ExPolygon.hpp>
+#include <libslic3r/Surface.hpp>
+#include <libnest2d/tools/benchmark.h>
+
+const std::string USAGE_STR = {
+    "Usage: geometrymoves [layers] [islands_per_layer]\n"
+    "Moves ExPolygons through the Surfaces / ExPolygons / Polylines conversions of the slicing steps "
+    "and counts the heap allocations."
+};
+
+static size_t g_num_allocations = 0;
+
+void* operator new(size_t size)
+{
+    ++ g_num_allocations;
+    if (void *ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+static Slic3r::Polygon circle(double cx, double cy, double radius, int num_points, bool ccw)
+{
+    Slic3r::Polygon out;
+    out.points.reserve(num_points);
+    for (int i = 0; i < num_points; ++ i) {
+        double a = (ccw ? 2. : -2.) * PI * i / num_points;
+        out.points.emplace_back(coord_t(scale_(cx + radius * cos(a))), coord_t(scale_(cy + radius * sin(a))));
+    }
+    return out;
+}
+
+int main(const int argc, const char *argv[]) {
+    using namespace Slic3r;
+    using std::cout; using std::endl;
+
+    if(argc > 1 && std::string(argv[1]) == "--help") {
+        cout << USAGE_STR << endl;
+        return EXIT_SUCCESS;
+    }
+
+    const int num_layers  = argc > 1 ? std::stoi(argv[1]) : 200;
+    const int num_islands = argc > 2 ? std::stoi(argv[2]) : 200;
+
+    Benchmark bench;
+    size_t    num_polylines = 0;
+    size_t    allocations0  = g_num_allocations;
+    bench.start();
+    for (int layer_id = 0; layer_id < num_layers; ++ layer_id) {
+        // The islands are collected without a reserve, the way the slicer grows its vectors.
+        ExPolygons expolygons;
+        for (int i = 0; i < num_islands; ++ i) {
+            ExPolygon expoly;
+            expoly.contour = circle(i * 10., layer_id, 4., 100, true);
+            for (int j = 0; j < 5; ++ j)
+                expoly.holes.emplace_back(circle(i * 10. + j - 2., layer_id, 0.3, 32, false));
+            expolygons.emplace_back(std::move(expoly));
+        }
+        Surfaces surfaces;
+        surfaces_append(surfaces, std::move(expolygons), Surface(stInternal, ExPolygon()));
+        Surfaces surfaces_grown;
+        for (Surface &surface : surfaces)
+            surfaces_grown.emplace_back(std::move(surface));
+        Polylines polylines = to_polylines(to_expolygons(std::move(surfaces_grown)));
+        num_polylines += polylines.size();
+    }
+    bench.stop();
+
+    cout << "Converted " << num_layers << " layers of " << num_islands << " islands: " << num_polylines << " polylines" << endl;
+    cout << "Heap allocations: " << g_num_allocations - allocations0 << endl;
+    cout << "Conversion time: " << bench.getElapsedSec() << " seconds." << endl;
+
+    return EXIT_SUCCESS;
+}
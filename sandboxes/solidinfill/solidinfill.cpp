@@ -0,0 +1,77 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+#include <libslic3r/libslic3r.h>
+#include <libslic3r/ExPolygon.hpp>
+#include <libslic3r/Surface.hpp>
+#include <libslic3r/Fill/FillBase.hpp>
+#include <libnest2d/tools/benchmark.h>
+
+const std::string USAGE_STR = {
+    "Usage: solidinfill [plate_size_mm] [holes_per_side] [layers]\n"
+    "Fills a square plate perforated by a grid of round holes with a solid rectilinear infill."
+};
+
+int main(const int argc, const char *argv[]) {
+    using namespace Slic3r;
+    using std::cout; using std::endl;
+
+    if(argc > 1 && std::string(argv[1]) == "--help") {
+        cout << USAGE_STR << endl;
+        return EXIT_SUCCESS;
+    }
+
+    const double plate_size     = argc > 1 ? std::stod(argv[1]) : 200.;
+    const int    holes_per_side = argc > 2 ? std::stoi(argv[2]) : 20;
+    const int    num_layers     = argc > 3 ? std::stoi(argv[3]) : 20;
+    const double spacing        = 0.45;
+
+    // A large solid layer: a plate with a grid of holes, so that each scan line crosses many contours.
+    const coord_t size = coord_t(scale_(plate_size));
+    ExPolygon plate;
+    plate.contour.points = { Point(0, 0), Point(size, 0), Point(size, size), Point(0, size) };
+    const double hole_pitch  = plate_size / holes_per_side;
+    const double hole_radius = 0.3 * hole_pitch;
+    for (int i = 0; i < holes_per_side; ++ i)
+        for (int j = 0; j < holes_per_side; ++ j) {
+            Polygon hole;
+            for (int k = 0; k < 64; ++ k) {
+                double a = - 2. * PI * k / 64.;
+                hole.points.emplace_back(
+                    scale_(hole_pitch * (i + 0.5) + hole_radius * cos(a)),
+                    scale_(hole_pitch * (j + 0.5) + hole_radius * sin(a)));
+            }
+            plate.holes.emplace_back(std::move(hole));
+        }
+    Surface surface(stInternalSolid, plate);
+
+    std::unique_ptr<Fill> fill(Fill::new_from_type(ipRectilinear));
+    fill->set_bounding_box(get_extents(plate.contour));
+    fill->spacing = spacing;
+    fill->angle   = float(PI / 4.);
+    FillParams params;
+    params.density     = 1.f;
+    params.dont_adjust = false;
+
+    Benchmark bench;
+    size_t    num_polylines = 0;
+    double    length        = 0.;
+    bench.start();
+    for (int layer_id = 0; layer_id < num_layers; ++ layer_id) {
+        fill->layer_id = layer_id;
+        Polylines polylines = fill->fill_surface(&surface, params);
+        num_polylines += polylines.size();
+        for (const Polyline &polyline : polylines)
+            length += unscale<double>(polyline.length());
+    }
+    bench.stop();
+
+    cout << "Filled " << num_layers << " layers of " << plate_size << "x" << plate_size << "mm with "
+         << holes_per_side * holes_per_side << " holes: " << num_polylines << " polylines, "
+         << std::setprecision(10) << length << " mm" << endl;
+    cout << "Solid infill time: " << bench.getElapsedSec() << " seconds." << endl;
+
+    return EXIT_SUCCESS;
+}
@@ -3,6 +3,8 @@
 #include "Geometry.hpp"
 #include <algorithm>
 
+#include <tbb/parallel_for.h>
+
 namespace Slic3r {
 
 BridgeDetector::BridgeDetector(
@@ -88,12 +90,23 @@ bool BridgeDetector::detect_angle(double bridge_direction_override)
         are inside the anchors and not on their contours leading to false negatives. */
     Polygons clip_area = offset(this->expolygons, 0.5f * float(this->spacing));
     
+    // Bounding boxes of the anchors to quickly reject the line end points outside of an anchor.
+    std::vector<BoundingBox> anchor_bboxes;
+    anchor_bboxes.reserve(this->_anchor_regions.size());
+    for (const ExPolygon &anchor : this->_anchor_regions)
+        anchor_bboxes.emplace_back(get_extents(anchor.contour));
+    auto anchored = [this, &anchor_bboxes](const Point &pt) -> bool {
+        for (size_t i = 0; i < anchor_bboxes.size(); ++ i)
+            if (anchor_bboxes[i].contains(pt) && this->_anchor_regions[i].contains(pt))
+                return true;
+        return false;
+    };
+
     /*  we'll now try several directions using a rudimentary visibility check:
         bridge in several directions and then sum the length of lines having both
         endpoints within anchors */
-        
-    bool have_coverage = false;
-    for (size_t i_angle = 0; i_angle < candidates.size(); ++ i_angle)
+    // The candidate directions are independent, they are evaluated in parallel.
+    auto evaluate_candidate = [this, &candidates, &clip_area, &anchored](size_t i_angle)
     {
         const double angle = candidates[i_angle].angle;
 
@@ -120,7 +133,7 @@ bool BridgeDetector::detect_angle(double bridge_direction_override)
             Lines clipped_lines = intersection_ln(lines, clip_area);
             for (size_t i = 0; i < clipped_lines.size(); ++i) {
                 const Line &line = clipped_lines[i];
-                if (expolygons_contain(this->_anchor_regions, line.a) && expolygons_contain(this->_anchor_regions, line.b)) {
+                if (anchored(line.a) && anchored(line.b)) {
                     // This line could be anchored.
                     double len = line.length();
                     total_length += len;
@@ -129,9 +142,8 @@ bool BridgeDetector::detect_angle(double bridge_direction_override)
             }        
         }
         if (total_length == 0.)
-            continue;
+            return;
 
-        have_coverage = true;
         // Sum length of bridged lines.
         candidates[i_angle].coverage = total_length;
         /*  The following produces more correct results in some cases and more broken in others.
@@ -139,9 +151,19 @@ bool BridgeDetector::detect_angle(double bridge_direction_override)
         // $directions_coverage{$angle} = sum(map $_->area, @{$self->coverage($angle)}) // 0;
         // max length of bridged lines
         candidates[i_angle].max_length = max_length;
-    }
+    };
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, candidates.size()),
+        [&evaluate_candidate](const tbb::blocked_range<size_t>& range) {
+            for (size_t i_angle = range.begin(); i_angle < range.end(); ++ i_angle)
+                evaluate_candidate(i_angle);
+        });
 
     // if no direction produced coverage, then there's no bridge direction
+    bool have_coverage = false;
+    for (const BridgeDirection &candidate : candidates)
+        if (candidate.coverage > 0.)
+            have_coverage = true;
     if (! have_coverage)
         return false;
     
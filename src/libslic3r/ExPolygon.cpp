@@ -193,6 +193,21 @@ void ExPolygon::simplify(double tolerance, ExPolygons* expolygons) const
 void
 ExPolygon::medial_axis(double max_width, double min_width, ThickPolylines* polylines) const
 {
+    /*  Skip inputs too narrow to produce any medial axis segment: the medial axis width is bounded
+        by the diameter of the largest inscribed circle, which can be neither larger than the shorter
+        side of the bounding box, nor larger than the diameter of a circle of the same area. 
+        Testing this is much cheaper than building the Voronoi diagram for thin walls and gaps that
+        would all be rejected anyway. */
+    if (this->contour.points.size() < 3)
+        return;
+    {
+        const Vec2d  size                = BoundingBox(this->contour.points).size().cast<double>();
+        const double max_width_inscribed = std::min(std::min(size(0), size(1)), 2. * sqrt(std::max(0., this->area()) / PI));
+        // SCALED_EPSILON covers the rounding of the Voronoi vertices to integer coordinates.
+        if (max_width_inscribed + SCALED_EPSILON < min_width)
+            return;
+    }
+
     // init helper object
     Slic3r::Geometry::MedialAxis ma(max_width, min_width, this);
     ma.lines = this->lines();
@@ -132,4 +132,108 @@ BoundingBox get_extents(const ExPolygonCollection &expolygon)
     return get_extents(expolygon.expolygons);
 }
 
+void ExPolygonsIndex::create(const std::vector<const ExPolygon*> &expolygons)
+{
+    this->clear();
+    if (expolygons.empty())
+        return;
+    m_items.reserve(expolygons.size());
+    for (const ExPolygon *expolygon : expolygons) {
+        Item item;
+        item.bbox = get_extents(expolygon->contour);
+        // Tolerate the rounding of the Clipper library when testing the polylines running along the contour.
+        item.bbox.offset(SCALED_EPSILON);
+        item.bbox.defined = true;
+        item.expolygon = expolygon;
+        m_bbox.merge(item.bbox);
+        m_items.emplace_back(item);
+    }
+    // Roughly a single cell per ExPolygon.
+    Point  size = m_bbox.size();
+    double cell_size = std::sqrt(double(size(0)) * double(size(1)) / double(m_items.size()));
+    m_cell_size = std::max<coord_t>(coord_t(cell_size), scale_(1.));
+    m_cols = size_t(size(0) / m_cell_size) + 1;
+    m_rows = size_t(size(1) / m_cell_size) + 1;
+    // Bucket sort the items into the cells overlapped by their bounding boxes.
+    m_cell_start.assign(m_cols * m_rows + 1, 0);
+    for (int pass = 0; pass < 2; ++ pass) {
+        for (size_t idx_item = 0; idx_item < m_items.size(); ++ idx_item) {
+            size_t col_min, col_max, row_min, row_max;
+            this->cell_range(m_items[idx_item].bbox, col_min, col_max, row_min, row_max);
+            for (size_t row = row_min; row <= row_max; ++ row)
+                for (size_t col = col_min; col <= col_max; ++ col) {
+                    size_t cell = row * m_cols + col;
+                    if (pass == 0)
+                        ++ m_cell_start[cell + 1];
+                    else
+                        m_cell_items[m_cell_start[cell] ++] = idx_item;
+                }
+        }
+        if (pass == 0) {
+            for (size_t cell = 1; cell < m_cell_start.size(); ++ cell)
+                m_cell_start[cell] += m_cell_start[cell - 1];
+            m_cell_items.assign(m_cell_start.back(), 0);
+        } else {
+            // The second pass shifted the starts to the ends of the cells, shift them back.
+            for (size_t cell = m_cell_start.size() - 1; cell > 0; -- cell)
+                m_cell_start[cell] = m_cell_start[cell - 1];
+            m_cell_start.front() = 0;
+        }
+    }
+}
+
+void ExPolygonsIndex::clear()
+{
+    m_items.clear();
+    m_bbox = BoundingBox();
+    m_cell_size = 0;
+    m_cols = 0;
+    m_rows = 0;
+    m_cell_start.clear();
+    m_cell_items.clear();
+}
+
+template<typename T>
+bool ExPolygonsIndex::contains_impl(const T &item, const BoundingBox &bbox) const
+{
+    if (m_items.empty() || ! m_bbox.contains(bbox.min) || ! m_bbox.contains(bbox.max))
+        return false;
+    // An ExPolygon containing the item has to overlap the cell of the item's min corner.
+    size_t col, row;
+    this->cell_of(bbox.min, col, row);
+    size_t cell = row * m_cols + col;
+    for (size_t i = m_cell_start[cell]; i < m_cell_start[cell + 1]; ++ i) {
+        const Item &candidate = m_items[m_cell_items[i]];
+        if (candidate.bbox.contains(bbox.min) && candidate.bbox.contains(bbox.max) && candidate.expolygon->contains(item))
+            return true;
+    }
+    return false;
+}
+
+size_t ExPolygonsIndex::find_containing(const Point &point) const
+{
+    if (m_items.empty() || ! m_bbox.contains(point))
+        return size_t(-1);
+    size_t col, row;
+    this->cell_of(point, col, row);
+    size_t cell = row * m_cols + col;
+    // The items of a cell are sorted by their indices.
+    for (size_t i = m_cell_start[cell]; i < m_cell_start[cell + 1]; ++ i) {
+        size_t idx = m_cell_items[i];
+        if (m_items[idx].bbox.contains(point) && m_items[idx].expolygon->contains(point))
+            return idx;
+    }
+    return size_t(-1);
+}
+
+bool ExPolygonsIndex::contains(const Point &point) const
+{
+    return this->contains_impl(point, BoundingBox(point, point));
+}
+
+bool ExPolygonsIndex::contains(const Polyline &polyline) const
+{
+    return ! polyline.points.empty() && this->contains_impl(polyline, get_extents(polyline));
+}
+
 }
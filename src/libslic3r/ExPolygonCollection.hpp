@@ -2,6 +2,7 @@
 #define slic3r_ExPolygonCollection_hpp_
 
 #include "libslic3r.h"
+#include "BoundingBox.hpp"
 #include "ExPolygon.hpp"
 #include "Line.hpp"
 #include "Polyline.hpp"
@@ -36,6 +37,77 @@ class ExPolygonCollection
 
 extern BoundingBox get_extents(const ExPolygonCollection &expolygon);
 
+// Uniform grid over the bounding boxes of a set of ExPolygons, to find the ExPolygons containing a point or a polyline
+// without testing all of them. Only pointers to the ExPolygons are stored, the index has to be recreated
+// whenever the ExPolygons are modified or moved.
+class ExPolygonsIndex
+{
+public:
+    ExPolygonsIndex() : m_cell_size(0), m_cols(0), m_rows(0) {}
+
+    void create(const std::vector<const ExPolygon*> &expolygons);
+    void clear();
+    bool empty() const { return m_items.empty(); }
+
+    // Same result as testing expolygon.contains(item) for all the indexed ExPolygons,
+    // though only the ExPolygons with a bounding box containing the item are tested.
+    bool contains(const Point &point) const;
+    bool contains(const Polyline &polyline) const;
+    // Index of the first ExPolygon passed to create(), which contains the point, or size_t(-1).
+    size_t find_containing(const Point &point) const;
+    // Call fn(idx) once for each ExPolygon with a bounding box overlapping bbox, where idx is the index
+    // of the ExPolygon passed to create(). The visiting is stopped once fn returns true.
+    template<typename Fn> bool visit_overlapping(const BoundingBox &bbox, Fn fn) const
+    {
+        if (m_items.empty() || ! m_bbox.overlap(bbox))
+            return false;
+        size_t col_min, col_max, row_min, row_max;
+        this->cell_range(bbox, col_min, col_max, row_min, row_max);
+        for (size_t row = row_min; row <= row_max; ++ row)
+            for (size_t col = col_min; col <= col_max; ++ col) {
+                size_t cell = row * m_cols + col;
+                for (size_t i = m_cell_start[cell]; i < m_cell_start[cell + 1]; ++ i) {
+                    size_t       idx  = m_cell_items[i];
+                    const Item  &item = m_items[idx];
+                    if (! item.bbox.overlap(bbox))
+                        continue;
+                    // Visit the item only in the cell of the min corner of its intersection with bbox.
+                    size_t c, r;
+                    this->cell_of(Point(std::max(item.bbox.min(0), bbox.min(0)), std::max(item.bbox.min(1), bbox.min(1))), c, r);
+                    if (c == col && r == row && fn(idx))
+                        return true;
+                }
+            }
+        return false;
+    }
+
+private:
+    struct Item {
+        BoundingBox          bbox;
+        const ExPolygon     *expolygon;
+    };
+    template<typename T> bool contains_impl(const T &item, const BoundingBox &bbox) const;
+    // Cell of a point, clamped to the grid.
+    void cell_of(const Point &pt, size_t &col, size_t &row) const {
+        col = size_t(std::min<coord_t>(std::max<coord_t>(pt(0) - m_bbox.min(0), 0) / m_cell_size, coord_t(m_cols - 1)));
+        row = size_t(std::min<coord_t>(std::max<coord_t>(pt(1) - m_bbox.min(1), 0) / m_cell_size, coord_t(m_rows - 1)));
+    }
+    void cell_range(const BoundingBox &bbox, size_t &col_min, size_t &col_max, size_t &row_min, size_t &row_max) const {
+        this->cell_of(bbox.min, col_min, row_min);
+        this->cell_of(bbox.max, col_max, row_max);
+    }
+
+    std::vector<Item>       m_items;
+    BoundingBox             m_bbox;
+    coord_t                 m_cell_size;
+    size_t                  m_cols;
+    size_t                  m_rows;
+    // Compressed rows: items of the i-th cell are m_cell_items[m_cell_start[i] .. m_cell_start[i + 1]).
+    std::vector<size_t>     m_cell_start;
+    std::vector<size_t>     m_cell_items;
+};
+
+
 }
 
 #endif
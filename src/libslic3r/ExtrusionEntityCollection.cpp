@@ -13,14 +13,28 @@ ExtrusionEntityCollection::ExtrusionEntityCollection(const ExtrusionPaths &paths
 
 ExtrusionEntityCollection& ExtrusionEntityCollection::operator= (const ExtrusionEntityCollection &other)
 {
-    this->entities      = other.entities;
-    for (size_t i = 0; i < this->entities.size(); ++i)
-        this->entities[i] = this->entities[i]->clone();
+    if (this == &other)
+        return *this;
+    // Release the entities owned by this collection before cloning the other's.
+    this->clear();
+    this->append(other.entities);
     this->orig_indices  = other.orig_indices;
     this->no_sort       = other.no_sort;
     return *this;
 }
 
+ExtrusionEntityCollection& ExtrusionEntityCollection::operator= (ExtrusionEntityCollection &&other)
+{
+    if (this == &other)
+        return *this;
+    // Release the entities owned by this collection before taking over the other's.
+    this->clear();
+    this->entities      = std::move(other.entities);
+    this->orig_indices  = std::move(other.orig_indices);
+    this->no_sort       = other.no_sort;
+    return *this;
+}
+
 void
 ExtrusionEntityCollection::swap(ExtrusionEntityCollection &c)
 {
@@ -49,10 +63,8 @@ ExtrusionEntityCollection::operator ExtrusionPaths() const
 ExtrusionEntityCollection*
 ExtrusionEntityCollection::clone() const
 {
-    ExtrusionEntityCollection* coll = new ExtrusionEntityCollection(*this);
-    for (size_t i = 0; i < coll->entities.size(); ++i)
-        coll->entities[i] = this->entities[i]->clone();
-    return coll;
+    // The copy constructor clones the entities already.
+    return new ExtrusionEntityCollection(*this);
 }
 
 void
@@ -192,8 +204,8 @@ ExtrusionEntityCollection::flatten(ExtrusionEntityCollection* retval) const
 {
     for (ExtrusionEntitiesPtr::const_iterator it = this->entities.begin(); it != this->entities.end(); ++it) {
         if ((*it)->is_collection()) {
-            ExtrusionEntityCollection* collection = dynamic_cast<ExtrusionEntityCollection*>(*it);
-            retval->append(collection->flatten().entities);
+            // Flatten directly into retval, not into a temporary collection to be cloned again.
+            static_cast<const ExtrusionEntityCollection*>(*it)->flatten(retval);
         } else {
             retval->append(**it);
         }
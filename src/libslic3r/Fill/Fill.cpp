@@ -9,6 +9,7 @@
 #include "../PrintConfig.hpp"
 #include "../Surface.hpp"
 
+#include "Fill.hpp"
 #include "FillBase.hpp"
 
 namespace Slic3r {
@@ -24,14 +25,42 @@ struct SurfaceGroupAttrib
     int     pattern;
 };
 
+Fill* FillPool::fill(InfillPattern pattern)
+{
+    size_t idx = size_t(pattern);
+    if (idx >= m_fills.size())
+        m_fills.resize(idx + 1);
+    if (! m_fills[idx])
+        m_fills[idx].reset(Fill::new_from_type(pattern));
+    return m_fills[idx].get();
+}
+
+// add thin fill regions
+// thin_fills are of C++ Slic3r::ExtrusionEntityCollection, perl type Slic3r::ExtrusionPath::Collection
+// Unpacks the collection, creates multiple collections per path.
+// The path type could be ExtrusionPath, ExtrusionLoop or ExtrusionEntityCollection.
+// Why the paths are unpacked?
+static void append_thin_fills(const LayerRegion &layerm, ExtrusionEntityCollection &out)
+{
+    for (const ExtrusionEntity *thin_fill : layerm.thin_fills.entities) {
+        ExtrusionEntityCollection &collection = *(new ExtrusionEntityCollection());
+        out.entities.push_back(&collection);
+        collection.entities.push_back(thin_fill->clone());
+    }
+}
+
 // Generate infills for Slic3r::Layer::Region.
 // The Slic3r::Layer::Region at this point of time may contain
 // surfaces of various types (internal/bridge/top/bottom/solid).
 // The infills are generated on the groups of surfaces with a compatible type. 
 // Returns an array of Slic3r::ExtrusionPath::Collection objects containing the infills generaed now
 // and the thin fills generated by generate_perimeters().
-void make_fill(LayerRegion &layerm, ExtrusionEntityCollection &out)
+void make_fill(LayerRegion &layerm, ExtrusionEntityCollection &out, FillPool *fill_pool)
 {    
+    FillPool local_fill_pool;
+    if (fill_pool == nullptr)
+        fill_pool = &local_fill_pool;
+
 //    Slic3r::debugf "Filling layer %d:\n", $layerm->layer->id;
     
     double  fill_density           = layerm.region()->config().fill_density;
@@ -169,7 +198,7 @@ void make_fill(LayerRegion &layerm, ExtrusionEntityCollection &out)
             continue;
         
         // get filler object
-        std::unique_ptr<Fill> f = std::unique_ptr<Fill>(Fill::new_from_type(fill_pattern));
+        Fill *f = fill_pool->fill(fill_pattern);
         f->set_bounding_box(layerm.layer()->object()->bounding_box());
         
         // calculate the actual flow we'll be using for this infill
@@ -258,16 +287,70 @@ void make_fill(LayerRegion &layerm, ExtrusionEntityCollection &out)
             flow.mm3_per_mm(), flow.width, flow.height);
     }
 
-    // add thin fill regions
-    // thin_fills are of C++ Slic3r::ExtrusionEntityCollection, perl type Slic3r::ExtrusionPath::Collection
-    // Unpacks the collection, creates multiple collections per path.
-    // The path type could be ExtrusionPath, ExtrusionLoop or ExtrusionEntityCollection.
-    // Why the paths are unpacked?
-    for (const ExtrusionEntity *thin_fill : layerm.thin_fills.entities) {
-        ExtrusionEntityCollection &collection = *(new ExtrusionEntityCollection());
-        out.entities.push_back(&collection);
-        collection.entities.push_back(thin_fill->clone());
+    append_thin_fills(layerm, out);
+}
+
+size_t fill_layer_period(const PrintRegionConfig &config)
+{
+    std::vector<InfillPattern> patterns { config.top_fill_pattern.value, config.bottom_fill_pattern.value, ipRectilinear };
+    if (config.fill_density.value > 0)
+        patterns.emplace_back(config.fill_pattern.value);
+    size_t period = 1;
+    for (InfillPattern pattern : patterns) {
+        std::unique_ptr<Fill> f(Fill::new_from_type(pattern));
+        size_t p = f->layer_period();
+        if (p == 0)
+            return 0;
+        // Least common multiple.
+        size_t a = period;
+        size_t b = p;
+        while (b != 0) {
+            size_t t = a % b;
+            a = b;
+            b = t;
+        }
+        period = period / a * p;
     }
+    return period;
+}
+
+static inline bool surfaces_equal(const Surface &lhs, const Surface &rhs)
+{
+    return lhs.surface_type == rhs.surface_type && lhs.thickness == rhs.thickness && lhs.thickness_layers == rhs.thickness_layers &&
+           lhs.bridge_angle == rhs.bridge_angle && lhs.expolygon.contour.points == rhs.expolygon.contour.points &&
+           lhs.expolygon.holes.size() == rhs.expolygon.holes.size() &&
+           std::equal(lhs.expolygon.holes.begin(), lhs.expolygon.holes.end(), rhs.expolygon.holes.begin(),
+                [](const Polygon &l, const Polygon &r) { return l.points == r.points; });
+}
+
+bool fill_repeats(const LayerRegion &layerm_src, const LayerRegion &layerm, size_t period)
+{
+    const Layer &layer_src = *layerm_src.layer();
+    const Layer &layer     = *layerm.layer();
+    // The first layer is printed with a different flow.
+    if (period == 0 || layer_src.id() == 0 || layer.id() != layer_src.id() + period || layer.height != layer_src.height ||
+        layerm.fill_surfaces.surfaces.size() != layerm_src.fill_surfaces.surfaces.size())
+        return false;
+    for (size_t i = 0; i < layerm.fill_surfaces.surfaces.size(); ++ i) {
+        const Surface &surface_src = layerm_src.fill_surfaces.surfaces[i];
+        const Surface &surface     = layerm.fill_surfaces.surfaces[i];
+        if (! surfaces_equal(surface_src, surface) ||
+            // The fill direction alternates with the layer ID divided by the number of combined layers.
+            (layer_src.id() / surface.thickness_layers) % period != (layer.id() / surface.thickness_layers) % period)
+            return false;
+    }
+    return true;
+}
+
+void copy_fill(const LayerRegion &layerm_src, const LayerRegion &layerm, ExtrusionEntityCollection &out)
+{
+    // make_fill() stores the thin fills of a layer region after the infill.
+    assert(layerm_src.fills.entities.size() >= layerm_src.thin_fills.entities.size());
+    size_t num_fills = layerm_src.fills.entities.size() - layerm_src.thin_fills.entities.size();
+    out.entities.reserve(out.entities.size() + num_fills + layerm.thin_fills.entities.size());
+    for (size_t i = 0; i < num_fills; ++ i)
+        out.entities.push_back(layerm_src.fills.entities[i]->clone());
+    append_thin_fills(layerm, out);
 }
 
 } // namespace Slic3r
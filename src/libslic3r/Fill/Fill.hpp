@@ -5,6 +5,9 @@
 #include <float.h>
 #include <stdint.h>
 
+#include <memory>
+#include <vector>
+
 #include "../libslic3r.h"
 #include "../BoundingBox.hpp"
 #include "../PrintConfig.hpp"
@@ -29,7 +32,30 @@ public:
     FillParams   params;
 };
 
-void make_fill(LayerRegion &layerm, ExtrusionEntityCollection &out);
+// Fill objects of the infill patterns created on demand and reused for all the surfaces filled by a single thread,
+// so that the data precomputed by a pattern (for example FillHoneycomb::cache) are not thrown away after each surface.
+// Not thread safe, each thread shall use its own pool.
+class FillPool
+{
+public:
+    // The returned Fill is owned by the pool. Its parameters are to be set up by the caller before each use.
+    Fill*   fill(InfillPattern pattern);
+
+private:
+    // Indexed by InfillPattern.
+    std::vector<std::unique_ptr<Fill>> m_fills;
+};
+
+// If fill_pool is null, the Fill objects are created for this call only.
+void make_fill(LayerRegion &layerm, ExtrusionEntityCollection &out, FillPool *fill_pool = nullptr);
+
+// Number of layers after which the infill of a region repeats if its fill surfaces repeat,
+// zero if the infill depends on the print Z.
+size_t fill_layer_period(const PrintRegionConfig &config);
+// Will make_fill() generate the same infill for the two layer regions, which are fill_layer_period() layers apart?
+bool   fill_repeats(const LayerRegion &layerm_src, const LayerRegion &layerm, size_t period);
+// Instead of make_fill(), copy the infill generated for a layer region, for which fill_repeats() holds.
+void   copy_fill(const LayerRegion &layerm_src, const LayerRegion &layerm, ExtrusionEntityCollection &out);
 
 } // namespace Slic3r
 
@@ -14,6 +14,7 @@ class Fill3DHoneycomb : public Fill
 public:
     virtual Fill* clone() const { return new Fill3DHoneycomb(*this); };
     virtual ~Fill3DHoneycomb() {}
+    virtual size_t layer_period() const { return 0; }
 
 	// require bridge flow since most of this pattern hangs in air
     virtual bool use_bridge_flow() const { return true; }
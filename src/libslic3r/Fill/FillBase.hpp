@@ -79,6 +79,10 @@ public:
     // Do not sort the fill lines to optimize the print head path?
     virtual bool no_sort() const { return false; }
 
+    // Number of layers after which the pattern repeats, if the surfaces to be filled repeat.
+    // Zero if the pattern depends on the print Z.
+    virtual size_t layer_period() const { return 2; }
+
     // Perform the fill.
     virtual Polylines fill_surface(const Surface *surface, const FillParams &params);
 
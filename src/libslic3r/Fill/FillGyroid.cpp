@@ -76,12 +76,11 @@ static std::vector<Vec2d> make_one_period(double width, double scaleFactor, doub
         // calculate distance of the point to the line:
         double dist_mm = unscale<double>(scaleFactor) * std::abs(cross2(rp, lp) - cross2(rp - lp, tp)) / lrv.norm();
         if (dist_mm > tolerance) {                               // if the difference from straight line is more than this
-            double x = 0.5f * (points[i-1](0) + points[i](0));
-            points.emplace_back(Vec2d(x, f(x, z_sin, z_cos, vertical, flip)));
-            x = 0.5f * (points[i+1](0) + points[i](0));
-            points.emplace_back(Vec2d(x, f(x, z_sin, z_cos, vertical, flip)));
-            // we added the points to the end, but need them all in order
-            std::sort(points.begin(), points.end(), [](const Vec2d &lhs, const Vec2d &rhs){ return lhs < rhs; });
+            double x1 = 0.5f * (points[i-1](0) + points[i](0));
+            double x2 = 0.5f * (points[i+1](0) + points[i](0));
+            // insert the new points in order, around the i-th point
+            points.insert(points.begin() + i + 1, Vec2d(x2, f(x2, z_sin, z_cos, vertical, flip)));
+            points.insert(points.begin() + i, Vec2d(x1, f(x1, z_sin, z_cos, vertical, flip)));
             // decrement i so we also check the first newly added point
             --i;
         }
@@ -89,7 +88,10 @@ static std::vector<Vec2d> make_one_period(double width, double scaleFactor, doub
     return points;
 }
 
-static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double line_spacing, double width, double height)
+// Don't let the cache grow over many layers with a different phase.
+static const size_t GYROID_CACHE_MAX_SIZE = 32;
+
+static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double line_spacing, double width, double height, FillGyroid::Cache &cache)
 {
     const double scaleFactor = scale_(line_spacing) / density_adjusted;
  //scale factor for 5% : 8 712 388
@@ -109,16 +111,25 @@ static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double
         std::swap(width,height);
     }
 
-    std::vector<Vec2d> one_period = make_one_period(width, scaleFactor, z_cos, z_sin, vertical, flip); // creates one period of the waves, so it doesn't have to be recalculated all the time
+    // creates one period of the waves, so it doesn't have to be recalculated all the time
+    // The period is cached for the other islands of the same layer, which only differ in width and height.
+    FillGyroid::CacheID cache_id(scaleFactor, z_sin, z_cos, std::min(2*M_PI, width));
+    auto it_cache = cache.find(cache_id);
+    if (it_cache == cache.end()) {
+        if (cache.size() >= GYROID_CACHE_MAX_SIZE)
+            cache.clear();
+        it_cache = cache.insert(it_cache, std::make_pair(cache_id, FillGyroid::CacheData()));
+        it_cache->second.odd  = make_one_period(width, scaleFactor, z_cos, z_sin, vertical, flip);
+        it_cache->second.even = make_one_period(width, scaleFactor, z_cos, z_sin, vertical, ! flip); // even polylines are a bit shifted
+    }
+    const FillGyroid::CacheData &periods = it_cache->second;
     Polylines result;
 
     for (double y0 = lower_bound; y0 < upper_bound+EPSILON; y0 += 2*M_PI)           // creates odd polylines
-            result.emplace_back(make_wave(one_period, width, height, y0, scaleFactor, z_cos, z_sin, vertical));
+            result.emplace_back(make_wave(periods.odd, width, height, y0, scaleFactor, z_cos, z_sin, vertical));
 
-    flip = !flip;                                                                   // even polylines are a bit shifted
-    one_period = make_one_period(width, scaleFactor, z_cos, z_sin, vertical, flip); // updates the one period sample
     for (double y0 = lower_bound + M_PI; y0 < upper_bound+EPSILON; y0 += 2*M_PI)    // creates even polylines
-            result.emplace_back(make_wave(one_period, width, height, y0, scaleFactor, z_cos, z_sin, vertical));
+            result.emplace_back(make_wave(periods.even, width, height, y0, scaleFactor, z_cos, z_sin, vertical));
 
     return result;
 }
@@ -146,7 +157,8 @@ void FillGyroid::_fill_surface_single(
         density_adjusted,
         this->spacing,
         ceil(bb.size()(0) / distance) + 1.,
-        ceil(bb.size()(1) / distance) + 1.);
+        ceil(bb.size()(1) / distance) + 1.,
+        this->cache);
     
     // move pattern in place
     for (Polyline &polyline : polylines)
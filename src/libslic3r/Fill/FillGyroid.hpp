@@ -1,6 +1,8 @@
 #ifndef slic3r_FillGyroid_hpp_
 #define slic3r_FillGyroid_hpp_
 
+#include <map>
+
 #include "../libslic3r.h"
 
 #include "FillBase.hpp"
@@ -12,10 +14,34 @@ class FillGyroid : public Fill
 public:
     FillGyroid() {}
     virtual Fill* clone() const { return new FillGyroid(*this); }
+    virtual size_t layer_period() const { return 0; }
 
     // require bridge flow since most of this pattern hangs in air
     virtual bool use_bridge_flow() const { return false; }
 
+    // Caching one period of the odd and even waves. The period only depends on the phase of the layer
+    // and on the wave scale, therefore it is shared by all the islands of a layer.
+    struct CacheID
+    {
+        CacheID(double ascale_factor, double az_sin, double az_cos, double alimit) :
+            scale_factor(ascale_factor), z_sin(az_sin), z_cos(az_cos), limit(alimit) {}
+        double      scale_factor;
+        double      z_sin;
+        double      z_cos;
+        double      limit;
+        bool operator<(const CacheID &other) const {
+            return scale_factor < other.scale_factor || (scale_factor == other.scale_factor && 
+                  (z_sin < other.z_sin || (z_sin == other.z_sin && 
+                  (z_cos < other.z_cos || (z_cos == other.z_cos && limit < other.limit)))));
+        }
+    };
+    struct CacheData
+    {
+        std::vector<Vec2d> odd;
+        std::vector<Vec2d> even;
+    };
+    typedef std::map<CacheID, CacheData> Cache;
+
 protected:
     virtual void _fill_surface_single(
         const FillParams                &params, 
@@ -23,6 +49,8 @@ protected:
         const std::pair<float, Point>   &direction, 
         ExPolygon                       &expolygon, 
         Polylines                       &polylines_out);
+
+    Cache cache;
 };
 
 } // namespace Slic3r
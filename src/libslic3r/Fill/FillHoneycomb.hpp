@@ -13,6 +13,7 @@ class FillHoneycomb : public Fill
 {
 public:
     virtual ~FillHoneycomb() {}
+    virtual size_t layer_period() const { return 3; }
 
 protected:
     virtual Fill* clone() const { return new FillHoneycomb(*this); };
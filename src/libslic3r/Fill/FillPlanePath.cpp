@@ -6,6 +6,56 @@
 
 namespace Slic3r {
 
+// Collects the points of a plane path, keeping just the segments touching a window.
+// The path is split into pieces where it leaves the window.
+class PlanePathClipper
+{
+public:
+    PlanePathClipper(const BoundingBoxf &window, std::vector<Pointfs> &out) : 
+        m_window(window), m_out(out), m_has_prev(false), m_inside(false) {}
+
+    bool    overlaps(const BoundingBoxf &bbox) const { return m_window.overlap(bbox); }
+
+    void    add(const Vec2d &pt) {
+        if (m_has_prev) {
+            if (m_window.overlap(BoundingBoxf(m_prev.cwiseMin(pt), m_prev.cwiseMax(pt)))) {
+                if (! m_inside) {
+                    m_out.emplace_back();
+                    m_out.back().emplace_back(m_prev);
+                    m_inside = true;
+                }
+                m_out.back().emplace_back(pt);
+            } else
+                m_inside = false;
+        }
+        m_prev     = pt;
+        m_has_prev = true;
+    }
+
+    // A part of the path was skipped, the next point does not connect to the previous one.
+    void    interrupt() { m_has_prev = false; m_inside = false; }
+
+    // Distance of the closest point of the window from the origin.
+    double  min_radius() const {
+        double dx = std::max(0., std::max(m_window.min(0), - m_window.max(0)));
+        double dy = std::max(0., std::max(m_window.min(1), - m_window.max(1)));
+        return std::sqrt(dx * dx + dy * dy);
+    }
+    // Distance of the farthest point of the window from the origin.
+    double  max_radius() const {
+        double dx = std::max(std::abs(m_window.min(0)), std::abs(m_window.max(0)));
+        double dy = std::max(std::abs(m_window.min(1)), std::abs(m_window.max(1)));
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+private:
+    BoundingBoxf          m_window;
+    std::vector<Pointfs> &m_out;
+    Vec2d                 m_prev;
+    bool                  m_has_prev;
+    bool                  m_inside;
+};
+
 void FillPlanePath::_fill_surface_single(
     const FillParams                &params, 
     unsigned int                     thickness_layers,
@@ -27,22 +77,32 @@ void FillPlanePath::_fill_surface_single(
     expolygon.translate(-shift(0), -shift(1));
     bounding_box.translate(-shift(0), -shift(1));
 
-    Pointfs pts = _generate(
+    // Generate just the part of the path over this expolygon, with a margin of one line spacing.
+    BoundingBox  bbox_expolygon = get_extents(expolygon.contour);
+    BoundingBoxf window(
+        Vec2d(double(bbox_expolygon.min(0)) / distance_between_lines - 1., double(bbox_expolygon.min(1)) / distance_between_lines - 1.),
+        Vec2d(double(bbox_expolygon.max(0)) / distance_between_lines + 1., double(bbox_expolygon.max(1)) / distance_between_lines + 1.));
+    std::vector<Pointfs> paths;
+    _generate(
         coord_t(ceil(coordf_t(bounding_box.min(0)) / distance_between_lines)),
         coord_t(ceil(coordf_t(bounding_box.min(1)) / distance_between_lines)),
         coord_t(ceil(coordf_t(bounding_box.max(0)) / distance_between_lines)),
-        coord_t(ceil(coordf_t(bounding_box.max(1)) / distance_between_lines)));
+        coord_t(ceil(coordf_t(bounding_box.max(1)) / distance_between_lines)),
+        window, paths);
 
     Polylines polylines;
-    if (pts.size() >= 2) {
-        // Convert points to a polyline, upscale.
-        polylines.push_back(Polyline());
-        Polyline &polyline = polylines.back();
-        polyline.points.reserve(pts.size());
-        for (Pointfs::iterator it = pts.begin(); it != pts.end(); ++ it)
-            polyline.points.push_back(Point(
-                coord_t(floor((*it)(0) * distance_between_lines + 0.5)), 
-                coord_t(floor((*it)(1) * distance_between_lines + 0.5))));
+    if (! paths.empty()) {
+        // Convert points to polylines, upscale.
+        polylines.reserve(paths.size());
+        for (const Pointfs &pts : paths) {
+            polylines.push_back(Polyline());
+            Polyline &polyline = polylines.back();
+            polyline.points.reserve(pts.size());
+            for (const Vec2d &pt : pts)
+                polyline.points.push_back(Point(
+                    coord_t(floor(pt(0) * distance_between_lines + 0.5)), 
+                    coord_t(floor(pt(1) * distance_between_lines + 0.5))));
+        }
 //      intersection(polylines_src, offset((Polygons)expolygon, scale_(0.02)), &polylines);
         polylines = intersection_pl(polylines, to_polygons(expolygon));
 
@@ -75,26 +135,45 @@ void FillPlanePath::_fill_surface_single(
 }
 
 // Follow an Archimedean spiral, in polar coordinates: r=a+b\theta
-Pointfs FillArchimedeanChords::_generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y)
+void FillArchimedeanChords::_generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y, const BoundingBoxf &window, std::vector<Pointfs> &out)
 {
+    PlanePathClipper clipper(window, out);
     // Radius to achieve.
     coordf_t rmax = std::sqrt(coordf_t(max_x)*coordf_t(max_x)+coordf_t(max_y)*coordf_t(max_y)) * std::sqrt(2.) + 1.5;
+    // The spiral is convex and its radius grows monotonously: The chords inside the circle touching the window
+    // do not touch the window, and the chords outside of the circle enclosing the window do not either.
+    coordf_t rmin_window = clipper.min_radius();
+    rmax = std::min(rmax, clipper.max_radius() + 1.);
     // Now unwind the spiral.
     coordf_t a = 1.;
     coordf_t b = 1./(2.*M_PI);
     coordf_t theta = 0.;
     coordf_t r = 1;
-    Pointfs out;
     //FIXME Vojtech: If used as a solid infill, there is a gap left at the center.
-    out.push_back(Vec2d(0, 0));
-    out.push_back(Vec2d(1, 0));
+    clipper.add(Vec2d(0, 0));
+    clipper.add(Vec2d(1, 0));
+    bool     skipped = false;
+    coordf_t theta_prev = theta;
+    coordf_t r_prev     = r;
     while (r < rmax) {
         // Discretization angle to achieve a discretization error lower than RESOLUTION.
         theta += 2. * acos(1. - RESOLUTION / r);
         r = a + b * theta;
-        out.push_back(Vec2d(r * cos(theta), r * sin(theta)));
+        if (r < rmin_window) {
+            // Don't evaluate the points inside the circle touching the window.
+            skipped    = true;
+            theta_prev = theta;
+            r_prev     = r;
+            continue;
+        }
+        if (skipped) {
+            // Emit the last skipped point to start the first chord touching the window.
+            clipper.interrupt();
+            clipper.add(Vec2d(r_prev * cos(theta_prev), r_prev * sin(theta_prev)));
+            skipped = false;
+        }
+        clipper.add(Vec2d(r * cos(theta), r * sin(theta)));
     }
-    return out;
 }
 
 // Adapted from 
@@ -145,7 +224,28 @@ static inline Point hilbert_n_to_xy(const size_t n)
     return Point(x, y);
 }
 
-Pointfs FillHilbertCurve::_generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y)
+// The 4^level points of the Hilbert curve starting at an index n0 aligned to 4^level fill an aligned square of 2^level x 2^level.
+// Skip the squares not touching the window, subdivide the others.
+static void hilbert_generate(size_t n0, size_t level, coord_t min_x, coord_t min_y, PlanePathClipper &clipper)
+{
+    if (level == 0) {
+        Point p = hilbert_n_to_xy(n0);
+        clipper.add(Vec2d(p(0) + min_x, p(1) + min_y));
+        return;
+    }
+    Point   p    = hilbert_n_to_xy(n0);
+    coord_t side = coord_t(1) << level;
+    Vec2d   corner(double((p(0) & ~(side - 1)) + min_x), double((p(1) & ~(side - 1)) + min_y));
+    if (! clipper.overlaps(BoundingBoxf(corner, corner + Vec2d(double(side - 1), double(side - 1))))) {
+        clipper.interrupt();
+        return;
+    }
+    size_t block = size_t(1) << (2 * (level - 1));
+    for (size_t i = 0; i < 4; ++ i)
+        hilbert_generate(n0 + i * block, level - 1, min_x, min_y, clipper);
+}
+
+void FillHilbertCurve::_generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y, const BoundingBoxf &window, std::vector<Pointfs> &out)
 {
     // Minimum power of two square to fit the domain.
     size_t sz = 2;
@@ -158,47 +258,50 @@ Pointfs FillHilbertCurve::_generate(coord_t min_x, coord_t min_y, coord_t max_x,
         }
     }
 
-    size_t sz2 = sz * sz;
-    Pointfs line;
-    line.reserve(sz2);
-    for (size_t i = 0; i < sz2; ++ i) {
-        Point p = hilbert_n_to_xy(i);
-        line.push_back(Vec2d(p(0) + min_x, p(1) + min_y));
-    }
-    return line;
+    PlanePathClipper clipper(window, out);
+    hilbert_generate(0, pw, min_x, min_y, clipper);
 }
 
-Pointfs FillOctagramSpiral::_generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y)
+void FillOctagramSpiral::_generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y, const BoundingBoxf &window, std::vector<Pointfs> &out)
 {
+    PlanePathClipper clipper(window, out);
     // Radius to achieve.
     coordf_t rmax = std::sqrt(coordf_t(max_x)*coordf_t(max_x)+coordf_t(max_y)*coordf_t(max_y)) * std::sqrt(2.) + 1.5;
+    coordf_t r_inc = sqrt(2.);
+    // The points of a ring of radius r are at a distance <r, (1 + sqrt(2)) r + r_inc> from the center,
+    // and the segments of a ring are at least r / sqrt(2) from the center.
+    // Skip the rings, which are completely inside the circle touching the window together with the next ring,
+    // stop at the rings completely outside of the circle enclosing the window.
+    coordf_t rmin_window = clipper.min_radius();
+    rmax = std::min(rmax, (clipper.max_radius() + r_inc) * sqrt(2.) + r_inc);
     // Now unwind the spiral.
     coordf_t r = 0;
-    coordf_t r_inc = sqrt(2.);
-    Pointfs out;
-    out.push_back(Vec2d(0, 0));
+    clipper.add(Vec2d(0, 0));
     while (r < rmax) {
         r += r_inc;
+        if ((1. + sqrt(2.)) * (r + r_inc) + r_inc < rmin_window) {
+            clipper.interrupt();
+            continue;
+        }
         coordf_t rx = r / sqrt(2.);
         coordf_t r2 = r + rx;
-        out.push_back(Vec2d( r,  0.));
-        out.push_back(Vec2d( r2, rx));
-        out.push_back(Vec2d( rx, rx));
-        out.push_back(Vec2d( rx, r2));
-        out.push_back(Vec2d(0.,  r));
-        out.push_back(Vec2d(-rx, r2));
-        out.push_back(Vec2d(-rx, rx));
-        out.push_back(Vec2d(-r2, rx));
-        out.push_back(Vec2d(-r,  0.));
-        out.push_back(Vec2d(-r2, -rx));
-        out.push_back(Vec2d(-rx, -rx));
-        out.push_back(Vec2d(-rx, -r2));
-        out.push_back(Vec2d(0., -r));
-        out.push_back(Vec2d( rx, -r2));
-        out.push_back(Vec2d( rx, -rx));
-        out.push_back(Vec2d( r2+r_inc, -rx));
+        clipper.add(Vec2d( r,  0.));
+        clipper.add(Vec2d( r2, rx));
+        clipper.add(Vec2d( rx, rx));
+        clipper.add(Vec2d( rx, r2));
+        clipper.add(Vec2d(0.,  r));
+        clipper.add(Vec2d(-rx, r2));
+        clipper.add(Vec2d(-rx, rx));
+        clipper.add(Vec2d(-r2, rx));
+        clipper.add(Vec2d(-r,  0.));
+        clipper.add(Vec2d(-r2, -rx));
+        clipper.add(Vec2d(-rx, -rx));
+        clipper.add(Vec2d(-rx, -r2));
+        clipper.add(Vec2d(0., -r));
+        clipper.add(Vec2d( rx, -r2));
+        clipper.add(Vec2d( rx, -rx));
+        clipper.add(Vec2d( r2+r_inc, -rx));
     }
-    return out;
 }
 
 } // namespace Slic3r
@@ -17,6 +17,7 @@ class FillPlanePath : public Fill
 {
 public:
     virtual ~FillPlanePath() {}
+    virtual size_t layer_period() const { return 1; }
 
 protected:
     virtual void _fill_surface_single(
@@ -28,7 +29,11 @@ protected:
 
     virtual float _layer_angle(size_t idx) const { return 0.f; }
     virtual bool  _centered() const = 0;
-    virtual Pointfs _generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y) = 0;
+    // Generate the path covering the bounding box of the object (min_x, min_y, max_x, max_y).
+    // Only the pieces of the path touching the window are emitted, so that filling a small island of a large object
+    // does not generate the path over the whole object. The path is the same for all the islands and layers, therefore
+    // the pieces stay aligned. All coordinates are in multiples of the line spacing.
+    virtual void  _generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y, const BoundingBoxf &window, std::vector<Pointfs> &out) = 0;
 };
 
 class FillArchimedeanChords : public FillPlanePath
@@ -39,7 +44,7 @@ public:
 
 protected:
     virtual bool  _centered() const { return true; }
-    virtual Pointfs _generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y);
+    virtual void  _generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y, const BoundingBoxf &window, std::vector<Pointfs> &out);
 };
 
 class FillHilbertCurve : public FillPlanePath
@@ -50,7 +55,7 @@ public:
 
 protected:
     virtual bool  _centered() const { return false; }
-    virtual Pointfs _generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y);
+    virtual void  _generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y, const BoundingBoxf &window, std::vector<Pointfs> &out);
 };
 
 class FillOctagramSpiral : public FillPlanePath
@@ -61,7 +66,7 @@ public:
 
 protected:
     virtual bool  _centered() const { return true; }
-    virtual Pointfs _generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y);
+    virtual void  _generate(coord_t min_x, coord_t min_y, coord_t max_x, coord_t max_y, const BoundingBoxf &window, std::vector<Pointfs> &out);
 };
 
 } // namespace Slic3r
@@ -175,7 +175,10 @@ public:
     {
         assert(pos_q > 0);
         assert(other.pos_q > 0);
-        if (pos_p == 0 || other.pos_p == 0) {
+        if (pos_q == other.pos_q) {
+            // Common denominator, for example both intersections at contour vertices.
+            return pos_p < other.pos_p;
+        } else if (pos_p == 0 || other.pos_p == 0) {
             // Because the denominators are positive and one of the nominators is zero,
             // following simple statement holds.
             return pos_p < other.pos_p;
@@ -752,6 +755,20 @@ static inline float measure_outer_contour_slab(
 }
 */
 
+// Range [il, ir] of the equally spaced vertical lines x0 + i * line_spacing, 0 <= i < n_vlines, crossing the x interval [l, r].
+// Returns false if no vertical line crosses the interval.
+static inline bool vlines_intersecting(coord_t l, coord_t r, coord_t x0, coord_t line_spacing, int n_vlines, int &il, int &ir)
+{
+    if (l > r)
+        std::swap(l, r);
+    // Rounding up and down of the divisions towards the closest vertical lines inside the interval.
+    coord_t dl = l - x0;
+    coord_t dr = r - x0;
+    il = std::max(int(0), int((dl <= 0) ? - (- dl / line_spacing) : (dl + line_spacing - 1) / line_spacing));
+    ir = std::min(n_vlines - 1, int((dr >= 0) ? dr / line_spacing : - ((- dr + line_spacing - 1) / line_spacing)));
+    return il <= ir;
+}
+
 enum DirectionMask
 {
     DIR_FORWARD  = 1,
@@ -832,6 +849,26 @@ bool FillRectilinear2::fill_surface_by_lines(const Surface *surface, const FillP
         segs[i].idx = i;
         segs[i].pos = x0 + i * line_spacing;
     }
+    // First count the intersections per vertical line to allocate the intersection vectors exactly,
+    // so that they are not reallocated while being filled in. Large solid surfaces produce millions of intersections.
+    {
+        std::vector<size_t> n_intersections(n_vlines, 0);
+        for (size_t iContour = 0; iContour < poly_with_offset.n_contours; ++ iContour) {
+            const Points &contour = poly_with_offset.contour(iContour).points;
+            if (contour.size() < 2)
+                continue;
+            for (size_t iSegment = 0; iSegment < contour.size(); ++ iSegment) {
+                const Point &p1 = contour[((iSegment == 0) ? contour.size() : iSegment) - 1];
+                const Point &p2 = contour[iSegment];
+                int il, ir;
+                if (p1(0) != p2(0) && vlines_intersecting(p1(0), p2(0), x0, line_spacing, int(n_vlines), il, ir))
+                    for (int i = il; i <= ir; ++ i)
+                        ++ n_intersections[i];
+            }
+        }
+        for (size_t i = 0; i < n_vlines; ++ i)
+            segs[i].intersections.reserve(n_intersections[i]);
+    }
     for (size_t iContour = 0; iContour < poly_with_offset.n_contours; ++ iContour) {
         const Points &contour = poly_with_offset.contour(iContour).points;
         if (contour.size() < 2)
@@ -847,15 +884,8 @@ bool FillRectilinear2::fill_surface_by_lines(const Surface *surface, const FillP
             if (l > r)
                 std::swap(l, r);
             // il, ir are the left / right indices of vertical lines intersecting a segment
-            int il = (l - x0) / line_spacing;
-            while (il * line_spacing + x0 < l)
-                ++ il;
-            il = std::max(int(0), il);
-            int ir = (r - x0 + line_spacing) / line_spacing;
-            while (ir * line_spacing + x0 > r)
-                -- ir;
-            ir = std::min(int(segs.size()) - 1, ir);
-            if (il > ir)
+            int il, ir;
+            if (! vlines_intersecting(l, r, x0, line_spacing, int(segs.size()), il, ir))
                 // No vertical line intersects this segment.
                 continue;
             assert(il >= 0 && il < segs.size());
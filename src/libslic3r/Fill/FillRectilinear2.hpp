@@ -26,6 +26,7 @@ public:
     virtual Fill* clone() const { return new FillGrid2(*this); };
     virtual ~FillGrid2() {}
     virtual Polylines fill_surface(const Surface *surface, const FillParams &params);
+    virtual size_t layer_period() const { return 1; }
 
 protected:
 	// The grid fill will keep the angle constant between the layers, see the implementation of Slic3r::Fill.
@@ -38,6 +39,7 @@ public:
     virtual Fill* clone() const { return new FillTriangles(*this); };
     virtual ~FillTriangles() {}
     virtual Polylines fill_surface(const Surface *surface, const FillParams &params);
+    virtual size_t layer_period() const { return 1; }
 
 protected:
 	// The grid fill will keep the angle constant between the layers, see the implementation of Slic3r::Fill.
@@ -50,6 +52,7 @@ public:
     virtual Fill* clone() const { return new FillStars(*this); };
     virtual ~FillStars() {}
     virtual Polylines fill_surface(const Surface *surface, const FillParams &params);
+    virtual size_t layer_period() const { return 1; }
 
 protected:
     // The grid fill will keep the angle constant between the layers, see the implementation of Slic3r::Fill.
@@ -62,6 +65,7 @@ public:
     virtual Fill* clone() const { return new FillCubic(*this); };
     virtual ~FillCubic() {}
     virtual Polylines fill_surface(const Surface *surface, const FillParams &params);
+    virtual size_t layer_period() const { return 0; }
 
 protected:
 	// The grid fill will keep the angle constant between the layers, see the implementation of Slic3r::Fill.
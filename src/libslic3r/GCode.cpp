@@ -21,6 +21,8 @@
 #include <boost/nowide/cstdio.hpp>
 #include <boost/nowide/cstdlib.hpp>
 
+#include <tbb/parallel_for.h>
+
 #include "SVG.hpp"
 
 #include <Shiny/Shiny.h>
@@ -59,6 +61,87 @@ Polyline AvoidCrossingPerimeters::travel_to(const GCode &gcodegen, const Point &
     return result;
 }
 
+void AvoidCrossingPerimeters::init_layer_mp(const Layer &layer, bool keep)
+{
+    if (&layer == m_layer_mp_layer)
+        // Another extruder printing at the same layer.
+        return;
+    m_layer_mp_layer = &layer;
+    auto it = m_layer_mps.find(&layer);
+    if (it == m_layer_mps.end()) {
+        m_layer_mp = std::make_shared<MotionPlanner>(union_ex(layer.slices, true));
+        if (keep && m_layer_mps.size() < m_layer_mps_capacity)
+            m_layer_mps.emplace(&layer, m_layer_mp);
+    } else {
+        m_layer_mp = it->second;
+        if (! keep)
+            m_layer_mps.erase(it);
+    }
+}
+
+// Create the distance field over the slices of a layer, to be used for the overhang detection by the seam placement.
+static std::shared_ptr<const EdgeGrid::Grid> create_lower_layer_edge_grid(const Layer &layer)
+{
+    const coord_t distance_field_resolution = coord_t(scale_(1.) + 0.5);
+    std::shared_ptr<EdgeGrid::Grid> grid = std::make_shared<EdgeGrid::Grid>();
+    grid->create(layer.slices, distance_field_resolution);
+    grid->calculate_sdf();
+    return grid;
+}
+
+void LowerLayerEdgeGridCache::prefetch(const std::vector<std::vector<const Layer*>> &layers, size_t idx)
+{
+    if (idx >= layers.size())
+        return;
+    bool cached = true;
+    for (const Layer *layer : layers[idx])
+        if (m_map.find(layer) == m_map.end()) {
+            cached = false;
+            break;
+        }
+    if (cached)
+        return;
+    // Collect the missing layers, leave the other half of the cache for the recently used grids.
+    std::vector<const Layer*> missing;
+    for (; idx < layers.size() && missing.size() < m_capacity / 2; ++ idx)
+        for (const Layer *layer : layers[idx])
+            if (m_map.find(layer) == m_map.end() && std::find(missing.begin(), missing.end(), layer) == missing.end())
+                missing.emplace_back(layer);
+    std::vector<std::shared_ptr<const EdgeGrid::Grid>> grids(missing.size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, missing.size()),
+        [&missing, &grids](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i)
+                grids[i] = create_lower_layer_edge_grid(*missing[i]);
+        });
+    // Insert in reverse, so that the grids needed first are the most recently used.
+    for (size_t i = missing.size(); i > 0; -- i)
+        this->insert(missing[i - 1], std::move(grids[i - 1]));
+}
+
+std::shared_ptr<const EdgeGrid::Grid> LowerLayerEdgeGridCache::get(const Layer *layer)
+{
+    auto it = m_map.find(layer);
+    if (it == m_map.end()) {
+        std::shared_ptr<const EdgeGrid::Grid> grid = create_lower_layer_edge_grid(*layer);
+        this->insert(layer, grid);
+        return grid;
+    }
+    // Move to the front of the LRU list.
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->second;
+}
+
+void LowerLayerEdgeGridCache::insert(const Layer *layer, std::shared_ptr<const EdgeGrid::Grid> grid)
+{
+    m_lru.emplace_front(layer, std::move(grid));
+    m_map[layer] = m_lru.begin();
+    while (m_lru.size() > m_capacity) {
+        m_map.erase(m_lru.back().first);
+        m_lru.pop_back();
+    }
+}
+
 std::string OozePrevention::pre_toolchange(GCode &gcodegen)
 {
     std::string gcode;
@@ -367,6 +450,15 @@ std::vector<GCode::LayerToPrint> GCode::collect_layers_to_print(const PrintObjec
     return layers_to_print;
 }
 
+// Collect the layer below the object layer to be printed, if the seam placement will query its edge grid.
+void GCode::collect_seam_lower_layers(const Print &print, const LayerToPrint &layer_to_print, std::vector<const Layer*> &lower_layers)
+{
+    const Layer *layer = layer_to_print.object_layer;
+    if (layer != nullptr && layer->lower_layer != nullptr && ! print.config().spiral_vase &&
+        layer->object()->config().seam_position.value != spRandom)
+        lower_layers.emplace_back(layer->lower_layer);
+}
+
 // Prepare for non-sequential printing of multiple objects: Support resp. object layers with nearly identical print_z 
 // will be printed for  all objects at once.
 // Return a list of <print_z, per object LayerToPrint> items.
@@ -491,6 +583,13 @@ void GCode::do_export(Print *print, const char *path, GCodePreviewData *preview_
         m_analyzer.reset();
     }
 
+    {
+        boost::system::error_code ec;
+        uintmax_t gcode_bytes = boost::filesystem::file_size(path_tmp, ec);
+        if (! ec)
+            print->set_step_counter(psGCodeExport, "gcode_bytes", size_t(gcode_bytes));
+    }
+
     if (rename_file(path_tmp, path) != 0)
         throw std::runtime_error(
             std::string("Failed to rename the output G-code file from ") + path_tmp + " to " + path + '\n' +
@@ -513,6 +612,10 @@ void GCode::_do_export(Print &print, FILE *file)
     m_normal_time_estimator.set_dialect(print.config().gcode_flavor);
     m_silent_time_estimator_enabled = (print.config().gcode_flavor == gcfMarlin) && print.config().silent_mode;
 
+    // Edge grids and motion planners cached by a previous export may refer to layers, which are no more valid.
+    m_lower_layer_edge_grids.clear();
+    m_avoid_crossing_perimeters.clear_layer_mps();
+
     // Until we have a UI support for the other firmwares than the Marlin, use the hardcoded default values
     // and let the user to enter the G-code limits into the start G-code.
     // If the following block is enabled for other firmwares than the Marlin, then the function
@@ -888,6 +991,7 @@ void GCode::_do_export(Print &print, FILE *file)
         size_t finished_objects = 0;
         for (size_t object_id = initial_print_object_id; object_id < objects.size(); ++ object_id) {
             const PrintObject &object = *objects[object_id];
+            m_avoid_crossing_perimeters.clear_layer_mps();
             for (const Point &copy : object.copies()) {
                 // Get optimal tool ordering to minimize tool switches of a multi-exruder print.
                 if (object_id != initial_print_object_id || &copy != object.copies().data()) {
@@ -928,11 +1032,20 @@ void GCode::_do_export(Print &print, FILE *file)
                 m_cooling_buffer->set_current_extruder(initial_extruder_id);
                 // Pair the object layers with the support layers by z, extrude them.
                 std::vector<LayerToPrint> layers_to_print = collect_layers_to_print(object);
+                std::vector<std::vector<const Layer*>> seam_lower_layers(layers_to_print.size());
+                for (size_t i = 0; i < layers_to_print.size(); ++ i)
+                    collect_seam_lower_layers(print, layers_to_print[i], seam_lower_layers[i]);
+                // Low memory mode: The extrusions of the last copy are released as soon as they are exported.
+                bool release_extrusions = print.release_extrusions_on_export() && &copy == &object.copies().back();
                 for (const LayerToPrint &ltp : layers_to_print) {
+                    // Calculate the edge grids for the seam placement of this and of the following layers in parallel.
+                    m_lower_layer_edge_grids.prefetch(seam_lower_layers, &ltp - layers_to_print.data());
                     std::vector<LayerToPrint> lrs;
                     lrs.emplace_back(std::move(ltp));
                     this->process_layer(file, print, lrs, tool_ordering.tools_for_layer(ltp.print_z()), &copy - object.copies().data());
                     print.throw_if_canceled();
+                    if (release_extrusions)
+                        objects[object_id]->release_extrusions(ltp.object_layer, ltp.support_layer);
                 }
 #ifdef HAS_PRESSURE_EQUALIZER
                 if (m_pressure_equalizer)
@@ -984,13 +1097,28 @@ void GCode::_do_export(Print &print, FILE *file)
             }
             print.throw_if_canceled();
         }
+        std::vector<std::vector<const Layer*>> seam_lower_layers(layers_to_print.size());
+        for (size_t i = 0; i < layers_to_print.size(); ++ i)
+            for (const LayerToPrint &ltp : layers_to_print[i].second)
+                collect_seam_lower_layers(print, ltp, seam_lower_layers[i]);
         // Extrude the layers.
         for (auto &layer : layers_to_print) {
+            // Calculate the edge grids for the seam placement of this and of the following layers in parallel.
+            m_lower_layer_edge_grids.prefetch(seam_lower_layers, &layer - layers_to_print.data());
             const LayerTools &layer_tools = tool_ordering.tools_for_layer(layer.first);
             if (m_wipe_tower && layer_tools.has_wipe_tower)
                 m_wipe_tower->next_layer();
             this->process_layer(file, print, layer.second, layer_tools, size_t(-1));
             print.throw_if_canceled();
+            if (print.release_extrusions_on_export()) {
+                // Low memory mode: Release the extrusions as soon as they are exported.
+                for (const LayerToPrint &ltp : layer.second)
+                    for (PrintObject *object : print.objects())
+                        if (object == ltp.object()) {
+                            object->release_extrusions(ltp.object_layer, ltp.support_layer);
+                            break;
+                        }
+            }
         }
 #ifdef HAS_PRESSURE_EQUALIZER
         if (m_pressure_equalizer)
@@ -1284,6 +1412,13 @@ void GCode::process_layer(
         // Nothing to extrude.
         return;
 
+    // The travel indices are only valid for the layers of a single print_z.
+    m_internal_slices_index.clear();
+    m_support_islands_index.clear();
+    // The motion planners of the object layers are kept for the other copies of an object printed sequentially.
+    if (single_object_idx == size_t(-1) || layers.front().object()->copies().size() == 1)
+        m_avoid_crossing_perimeters.clear_layer_mps();
+
     // Extract 1st object_layer and support_layer of this set of layers with an equal print_z.
     const Layer         *object_layer  = nullptr;
     const SupportLayer  *support_layer = nullptr;
@@ -1554,7 +1689,7 @@ void GCode::process_layer(
     } // for objects
 
     // Extrude the skirt, brim, support, perimeters, infill ordered by the extruders.
-    std::vector<std::unique_ptr<EdgeGrid::Grid>> lower_layer_edge_grids(layers.size());
+    std::vector<std::shared_ptr<const EdgeGrid::Grid>> lower_layer_edge_grids(layers.size());
     for (unsigned int extruder_id : layer_tools.extruders)
     {
         gcode += (layer_tools.has_wipe_tower && m_wipe_tower) ?
@@ -1624,7 +1759,10 @@ void GCode::process_layer(
                 m_config.apply(print_object->config(), true);
                 m_layer = layers[layer_id].layer();
                 if (m_config.avoid_crossing_perimeters)
-                    m_avoid_crossing_perimeters.init_layer_mp(union_ex(m_layer->slices, true));
+                    // Keep the planner for the other objects printed at this print_z, or for the next copies
+                    // of a sequentially printed object.
+                    m_avoid_crossing_perimeters.init_layer_mp(*m_layer,
+                        single_object_idx == size_t(-1) || single_object_idx + 1 < print_object->copies().size());
                 Points copies;
                 if (single_object_idx == size_t(-1))
                     copies = print_object->copies();
@@ -1982,18 +2120,15 @@ std::vector<float> polygon_angles_at_vertices(const Polygon &polygon, const std:
     return angles;
 }
 
-std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, double speed, std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid)
+std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, double speed, std::shared_ptr<const EdgeGrid::Grid> *lower_layer_edge_grid)
 {
     // get a copy; don't modify the orientation of the original loop object otherwise
     // next copies (if any) would not detect the correct orientation
 
     if (m_layer->lower_layer != nullptr && lower_layer_edge_grid != nullptr) {
         if (! *lower_layer_edge_grid) {
-            // Create the distance field for a layer below.
-            const coord_t distance_field_resolution = coord_t(scale_(1.) + 0.5);
-            *lower_layer_edge_grid = make_unique<EdgeGrid::Grid>();
-            (*lower_layer_edge_grid)->create(m_layer->lower_layer->slices, distance_field_resolution);
-            (*lower_layer_edge_grid)->calculate_sdf();
+            // Retrieve the distance field for a layer below, it has likely been calculated in advance by GCode::_do_export().
+            *lower_layer_edge_grid = m_lower_layer_edge_grids.get(m_layer->lower_layer);
             #if 0
             {
                 static int iRun = 0;
@@ -2264,7 +2399,7 @@ std::string GCode::extrude_multi_path(ExtrusionMultiPath multipath, std::string
     return gcode;
 }
 
-std::string GCode::extrude_entity(const ExtrusionEntity &entity, std::string description, double speed, std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid)
+std::string GCode::extrude_entity(const ExtrusionEntity &entity, std::string description, double speed, std::shared_ptr<const EdgeGrid::Grid> *lower_layer_edge_grid)
 {
     if (const ExtrusionPath* path = dynamic_cast<const ExtrusionPath*>(&entity))
         return this->extrude_path(*path, description, speed);
@@ -2293,7 +2428,7 @@ std::string GCode::extrude_path(ExtrusionPath path, std::string description, dou
 }
 
 // Extrude perimeters: Decide where to put seams (hide or align seams).
-std::string GCode::extrude_perimeters(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region, std::unique_ptr<EdgeGrid::Grid> &lower_layer_edge_grid)
+std::string GCode::extrude_perimeters(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region, std::shared_ptr<const EdgeGrid::Grid> &lower_layer_edge_grid)
 {
     std::string gcode;
     for (const ObjectByExtruder::Island::Region &region : by_region) {
@@ -2626,20 +2761,40 @@ bool GCode::needs_retraction(const Polyline &travel, ExtrusionRole role)
     
     if (role == erSupportMaterial) {
         const SupportLayer* support_layer = dynamic_cast<const SupportLayer*>(m_layer);
-        //FIXME support_layer->support_islands.contains should use some search structure!
-        if (support_layer != NULL && support_layer->support_islands.contains(travel))
-            // skip retraction if this is a travel move inside a support material island
-            //FIXME not retracting over a long path may cause oozing, which in turn may result in missing material
-            // at the end of the extrusion path!
-            return false;
+        if (support_layer != NULL) {
+            auto it = m_support_islands_index.find(support_layer);
+            if (it == m_support_islands_index.end()) {
+                std::vector<const ExPolygon*> islands;
+                islands.reserve(support_layer->support_islands.expolygons.size());
+                for (const ExPolygon &island : support_layer->support_islands.expolygons)
+                    islands.emplace_back(&island);
+                it = m_support_islands_index.emplace(support_layer, ExPolygonsIndex()).first;
+                it->second.create(islands);
+            }
+            if (it->second.contains(travel))
+                // skip retraction if this is a travel move inside a support material island
+                //FIXME not retracting over a long path may cause oozing, which in turn may result in missing material
+                // at the end of the extrusion path!
+                return false;
+        }
     }
 
-    if (m_config.only_retract_when_crossing_perimeters && m_layer != nullptr &&
-        m_config.fill_density.value > 0 && m_layer->any_internal_region_slice_contains(travel))
-        // Skip retraction if travel is contained in an internal slice *and*
-        // internal infill is enabled (so that stringing is entirely not visible).
-        //FIXME any_internal_region_slice_contains() is potentionally very slow, it shall test for the bounding boxes first.
-        return false;
+    if (m_config.only_retract_when_crossing_perimeters && m_layer != nullptr && m_config.fill_density.value > 0) {
+        auto it = m_internal_slices_index.find(m_layer);
+        if (it == m_internal_slices_index.end()) {
+            std::vector<const ExPolygon*> slices;
+            for (const LayerRegion *layerm : m_layer->regions())
+                for (const Surface &surface : layerm->slices.surfaces)
+                    if (surface.is_internal())
+                        slices.emplace_back(&surface.expolygon);
+            it = m_internal_slices_index.emplace(m_layer, ExPolygonsIndex()).first;
+            it->second.create(slices);
+        }
+        if (it->second.contains(travel))
+            // Skip retraction if travel is contained in an internal slice *and*
+            // internal infill is enabled (so that stringing is entirely not visible).
+            return false;
+    }
     
     // retract if only_retract_when_crossing_perimeters is disabled or doesn't apply
     return true;
@@ -3,6 +3,7 @@
 
 #include "libslic3r.h"
 #include "ExPolygon.hpp"
+#include "ExPolygonCollection.hpp"
 #include "GCodeWriter.hpp"
 #include "Layer.hpp"
 #include "MotionPlanner.hpp"
@@ -18,6 +19,8 @@
 #include "EdgeGrid.hpp"
 #include "GCode/Analyzer.hpp"
 
+#include <list>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -42,17 +45,54 @@ public:
     // we enable it by default for the first travel move in print
     bool disable_once;
     
-    AvoidCrossingPerimeters() : use_external_mp(false), use_external_mp_once(false), disable_once(true) {}
+    AvoidCrossingPerimeters(size_t layer_mps_capacity = 64) :
+        use_external_mp(false), use_external_mp_once(false), disable_once(true), m_layer_mps_capacity(layer_mps_capacity) {}
     ~AvoidCrossingPerimeters() {}
 
     void init_external_mp(const ExPolygons &islands) { m_external_mp = Slic3r::make_unique<MotionPlanner>(islands); }
-    void init_layer_mp(const ExPolygons &islands) { m_layer_mp = Slic3r::make_unique<MotionPlanner>(islands); }
+    // Activate the motion planner over the slices of an object layer. The extruders printing at that layer share
+    // the planner and the graphs it generated. If keep is set, the planner is cached for the other objects printed
+    // at the same print_z or for the next copy of a sequentially printed object, otherwise a cached entry is released.
+    // The copies visit the layers in the same order, therefore the number of cached planners is capped by keeping
+    // the first ones, as a least recently used cache would release each planner before it is reused.
+    void init_layer_mp(const Layer &layer, bool keep);
+    // Release the cached motion planners of the object layers except for the active one.
+    void clear_layer_mps() { m_layer_mps.clear(); m_layer_mp_layer = nullptr; }
 
     Polyline travel_to(const GCode &gcodegen, const Point &point);
 
 private:
     std::unique_ptr<MotionPlanner> m_external_mp;
-    std::unique_ptr<MotionPlanner> m_layer_mp;
+    std::shared_ptr<MotionPlanner> m_layer_mp;
+    // Layer of the active m_layer_mp.
+    const Layer                   *m_layer_mp_layer = nullptr;
+    size_t                         m_layer_mps_capacity;
+    std::map<const Layer*, std::shared_ptr<MotionPlanner>> m_layer_mps;
+};
+
+// Cache of the EdgeGrids with signed distance fields over the slices of object layers, used by the seam placement
+// of GCode::extrude_loop() to penalize seams over the overhangs. The grids of the layers to be exported next
+// are calculated in parallel in advance, so that the seam placement does not wait for their construction.
+// The number of cached grids is bounded, the least recently used grids are released first.
+class LowerLayerEdgeGridCache {
+public:
+    LowerLayerEdgeGridCache(size_t capacity = 64) : m_capacity(std::max<size_t>(capacity, 2)) {}
+
+    // Make sure the edge grids of layers[idx] are cached. If they are not, calculate in parallel
+    // the edge grids of layers[idx], layers[idx + 1] ... up to a half of the cache capacity.
+    void prefetch(const std::vector<std::vector<const Layer*>> &layers, size_t idx);
+    // Return the edge grid over the slices of a layer. Calculate it if it is not cached.
+    std::shared_ptr<const EdgeGrid::Grid> get(const Layer *layer);
+    void clear() { m_lru.clear(); m_map.clear(); }
+
+private:
+    void insert(const Layer *layer, std::shared_ptr<const EdgeGrid::Grid> grid);
+
+    typedef std::list<std::pair<const Layer*, std::shared_ptr<const EdgeGrid::Grid>>> LRUList;
+    size_t                                          m_capacity;
+    // Most recently used first.
+    LRUList                                         m_lru;
+    std::map<const Layer*, LRUList::iterator>       m_map;
 };
 
 class OozePrevention {
@@ -197,6 +237,7 @@ protected:
     };
     static std::vector<GCode::LayerToPrint>                            collect_layers_to_print(const PrintObject &object);
     static std::vector<std::pair<coordf_t, std::vector<LayerToPrint>>> collect_layers_to_print(const Print &print);
+    static void                                                        collect_seam_lower_layers(const Print &print, const LayerToPrint &layer_to_print, std::vector<const Layer*> &lower_layers);
     void            process_layer(
         // Write into the output file.
         FILE                            *file,
@@ -213,8 +254,8 @@ protected:
     void            set_extruders(const std::vector<unsigned int> &extruder_ids);
     std::string     preamble();
     std::string     change_layer(coordf_t print_z);
-    std::string     extrude_entity(const ExtrusionEntity &entity, std::string description = "", double speed = -1., std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid = nullptr);
-    std::string     extrude_loop(ExtrusionLoop loop, std::string description, double speed = -1., std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid = nullptr);
+    std::string     extrude_entity(const ExtrusionEntity &entity, std::string description = "", double speed = -1., std::shared_ptr<const EdgeGrid::Grid> *lower_layer_edge_grid = nullptr);
+    std::string     extrude_loop(ExtrusionLoop loop, std::string description, double speed = -1., std::shared_ptr<const EdgeGrid::Grid> *lower_layer_edge_grid = nullptr);
     std::string     extrude_multi_path(ExtrusionMultiPath multipath, std::string description = "", double speed = -1.);
     std::string     extrude_path(ExtrusionPath path, std::string description = "", double speed = -1.);
 
@@ -252,7 +293,7 @@ protected:
     };
 
 
-    std::string     extrude_perimeters(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region, std::unique_ptr<EdgeGrid::Grid> &lower_layer_edge_grid);
+    std::string     extrude_perimeters(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region, std::shared_ptr<const EdgeGrid::Grid> &lower_layer_edge_grid);
     std::string     extrude_infill(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region);
     std::string     extrude_support(const ExtrusionEntityCollection &support_fills);
 
@@ -296,6 +337,12 @@ protected:
     // In non-sequential mode, all its copies will be printed.
     const Layer*                        m_layer;
     std::map<const PrintObject*,Point>  m_seam_position;
+    // Edge grids over the lower layers for the seam placement.
+    LowerLayerEdgeGridCache             m_lower_layer_edge_grids;
+    // Spatial indices over the internal region slices of the object layers resp. over the support islands,
+    // created on demand by needs_retraction() and released when the next print_z is processed.
+    std::map<const Layer*, ExPolygonsIndex> m_internal_slices_index;
+    std::map<const Layer*, ExPolygonsIndex> m_support_islands_index;
     double                              m_volumetric_speed;
     // Support for the extrusion role markers. Which marker is active?
     ExtrusionRole                       m_last_extrusion_role;
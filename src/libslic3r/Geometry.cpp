@@ -892,10 +892,26 @@ private:
     const Lines &lines;
 };
 
+MedialAxis::MedialAxis(double _max_width, double _min_width, const ExPolygon* _expolygon)
+    : expolygon(_expolygon), max_width(_max_width), min_width(_min_width), storage(thread_storage()), vd(storage.vd)
+{
+}
+
+MedialAxis::ThreadStorage&
+MedialAxis::thread_storage()
+{
+    static thread_local ThreadStorage storage;
+    return storage;
+}
+
 void
 MedialAxis::build(ThickPolylines* polylines)
 {
-    construct_voronoi(this->lines.begin(), this->lines.end(), &this->vd);
+    // Equivalent to construct_voronoi(), but reusing the builder and diagram storage of this thread.
+    this->storage.builder.clear();
+    this->vd.clear();
+    boost::polygon::insert(this->lines.begin(), this->lines.end(), &this->storage.builder);
+    this->storage.builder.construct(&this->vd);
     
     /*
     // DEBUG: dump all Voronoi edges
@@ -916,41 +932,46 @@ MedialAxis::build(ThickPolylines* polylines)
     typedef const VD::edge_type   edge_t;
     
     // collect valid edges (i.e. prune those not belonging to MAT)
-    // note: this keeps twins, so it inserts twice the number of the valid edges
-    this->valid_edges.clear();
-    {
-        std::set<const VD::edge_type*> seen_edges;
-        for (VD::const_edge_iterator edge = this->vd.edges().begin(); edge != this->vd.edges().end(); ++edge) {
-            // if we only process segments representing closed loops, none if the
-            // infinite edges (if any) would be part of our MAT anyway
-            if (edge->is_secondary() || edge->is_infinite()) continue;
+    // note: this keeps twins, so it marks twice the number of the valid edges
+    const size_t num_edges = this->vd.edges().size();
+    this->storage.edge_flags.assign(num_edges, 0);
+    this->storage.thickness.resize(num_edges);
+    for (VD::const_edge_iterator edge = this->vd.edges().begin(); edge != this->vd.edges().end(); ++edge) {
+        // if we only process segments representing closed loops, none if the
+        // infinite edges (if any) would be part of our MAT anyway
+        if (edge->is_secondary() || edge->is_infinite()) continue;
+    
+        // don't re-validate twins
+        if (this->edge_has_flag(&*edge, EDGE_SEEN)) continue;  // TODO: is this needed?
+        this->edge_set_flag(&*edge, EDGE_SEEN);
+        this->edge_set_flag(edge->twin(), EDGE_SEEN);
         
-            // don't re-validate twins
-            if (seen_edges.find(&*edge) != seen_edges.end()) continue;  // TODO: is this needed?
-            seen_edges.insert(&*edge);
-            seen_edges.insert(edge->twin());
-            
-            if (!this->validate_edge(&*edge)) continue;
-            this->valid_edges.insert(&*edge);
-            this->valid_edges.insert(edge->twin());
-        }
+        if (!this->validate_edge(&*edge)) continue;
+        this->edge_set_flag(&*edge, EDGE_VALID);
+        this->edge_set_flag(edge->twin(), EDGE_VALID);
+        this->edge_set_flag(&*edge, EDGE_AVAILABLE);
+        this->edge_set_flag(edge->twin(), EDGE_AVAILABLE);
     }
-    this->edges = this->valid_edges;
     
     // iterate through the valid edges to build polylines
-    while (!this->edges.empty()) {
-        const edge_t* edge = *this->edges.begin();
+    // Edges are only ever consumed, therefore the first available edge is searched for
+    // starting from the last one found. The edges are visited in the order of their addresses,
+    // as they used to be when the available edges were stored in a std::set.
+    for (size_t idx_edge = 0; idx_edge < num_edges; ++ idx_edge) {
+        if (! (this->storage.edge_flags[idx_edge] & EDGE_AVAILABLE))
+            continue;
+        const edge_t* edge = &this->vd.edges()[idx_edge];
         
         // start a polyline
         ThickPolyline polyline;
         polyline.points.push_back(Point( edge->vertex0()->x(), edge->vertex0()->y() ));
         polyline.points.push_back(Point( edge->vertex1()->x(), edge->vertex1()->y() ));
-        polyline.width.push_back(this->thickness[edge].first);
-        polyline.width.push_back(this->thickness[edge].second);
+        polyline.width.push_back(this->edge_thickness(edge).first);
+        polyline.width.push_back(this->edge_thickness(edge).second);
         
         // remove this edge and its twin from the available edges
-        (void)this->edges.erase(edge);
-        (void)this->edges.erase(edge->twin());
+        this->edge_clear_flag(edge, EDGE_AVAILABLE);
+        this->edge_clear_flag(edge->twin(), EDGE_AVAILABLE);
         
         // get next points
         this->process_edge_neighbors(edge, &polyline);
@@ -1013,7 +1034,7 @@ MedialAxis::process_edge_neighbors(const VD::edge_type* edge, ThickPolyline* pol
         std::vector<const VD::edge_type*> neighbors;
         for (const VD::edge_type* neighbor = twin->rot_next(); neighbor != twin;
             neighbor = neighbor->rot_next()) {
-            if (this->valid_edges.count(neighbor) > 0) neighbors.push_back(neighbor);
+            if (this->edge_has_flag(neighbor, EDGE_VALID)) neighbors.push_back(neighbor);
         }
     
         // if we have a single neighbor then we can continue recursively
@@ -1021,14 +1042,14 @@ MedialAxis::process_edge_neighbors(const VD::edge_type* edge, ThickPolyline* pol
             const VD::edge_type* neighbor = neighbors.front();
             
             // break if this is a closed loop
-            if (this->edges.count(neighbor) == 0) return;
+            if (! this->edge_has_flag(neighbor, EDGE_AVAILABLE)) return;
             
             Point new_point(neighbor->vertex1()->x(), neighbor->vertex1()->y());
             polyline->points.push_back(new_point);
-            polyline->width.push_back(this->thickness[neighbor].first);
-            polyline->width.push_back(this->thickness[neighbor].second);
-            (void)this->edges.erase(neighbor);
-            (void)this->edges.erase(neighbor->twin());
+            polyline->width.push_back(this->edge_thickness(neighbor).first);
+            polyline->width.push_back(this->edge_thickness(neighbor).second);
+            this->edge_clear_flag(neighbor, EDGE_AVAILABLE);
+            this->edge_clear_flag(neighbor->twin(), EDGE_AVAILABLE);
             edge = neighbor;
         } else if (neighbors.size() == 0) {
             polyline->endpoints.second = true;
@@ -1137,8 +1158,8 @@ MedialAxis::validate_edge(const VD::edge_type* edge)
     if (w0 > this->max_width && w1 > this->max_width)
         return false;
     
-    this->thickness[edge]         = std::make_pair(w0, w1);
-    this->thickness[edge->twin()] = std::make_pair(w1, w0);
+    this->storage.thickness[this->edge_idx(edge)]         = std::make_pair(w0, w1);
+    this->storage.thickness[this->edge_idx(edge->twin())] = std::make_pair(w1, w0);
     
     return true;
 }
@@ -149,8 +149,9 @@ class MedialAxis {
     const ExPolygon* expolygon;
     double max_width;
     double min_width;
-    MedialAxis(double _max_width, double _min_width, const ExPolygon* _expolygon = NULL)
-        : expolygon(_expolygon), max_width(_max_width), min_width(_min_width) {};
+    // Only a single MedialAxis may be alive on a thread at a time, as the Voronoi diagram
+    // and the working buffers are shared by all MedialAxis instances running on the same thread.
+    MedialAxis(double _max_width, double _min_width, const ExPolygon* _expolygon = NULL);
     void build(ThickPolylines* polylines);
     void build(Polylines* polylines);
     
@@ -162,9 +163,33 @@ class MedialAxis {
         typedef boost::polygon::segment_data<coordinate_type>   segment_type;
         typedef boost::polygon::rectangle_data<coordinate_type> rect_type;
     };
-    VD vd;
-    std::set<const VD::edge_type*> edges, valid_edges;
-    std::map<const VD::edge_type*, std::pair<coordf_t,coordf_t> > thickness;
+    // Voronoi builder, Voronoi diagram and per edge working data, allocated once per thread
+    // and reused by all MedialAxis instances, so that the medial axis of many small ExPolygons
+    // does not reallocate the Voronoi structures for each ExPolygon.
+    struct ThreadStorage {
+        boost::polygon::default_voronoi_builder             builder;
+        VD                                                  vd;
+        // Combination of EdgeFlags, indexed by edge_idx().
+        std::vector<unsigned char>                          edge_flags;
+        // Thickness at vertex0 and vertex1 of valid edges, indexed by edge_idx().
+        std::vector<std::pair<coordf_t,coordf_t>>           thickness;
+    };
+    static ThreadStorage& thread_storage();
+    enum EdgeFlags : unsigned char {
+        // Edge or its twin has been validated.
+        EDGE_SEEN       = 1,
+        // Edge belongs to the medial axis.
+        EDGE_VALID      = 2,
+        // Valid edge not yet consumed by a polyline.
+        EDGE_AVAILABLE  = 4,
+    };
+    ThreadStorage &storage;
+    VD            &vd;
+    size_t edge_idx(const VD::edge_type* edge) const { return edge - &this->vd.edges().front(); }
+    bool   edge_has_flag(const VD::edge_type* edge, EdgeFlags flag) const { return (this->storage.edge_flags[this->edge_idx(edge)] & flag) != 0; }
+    void   edge_set_flag(const VD::edge_type* edge, EdgeFlags flag) { this->storage.edge_flags[this->edge_idx(edge)] |= flag; }
+    void   edge_clear_flag(const VD::edge_type* edge, EdgeFlags flag) { this->storage.edge_flags[this->edge_idx(edge)] &= ~flag; }
+    const std::pair<coordf_t,coordf_t>& edge_thickness(const VD::edge_type* edge) const { return this->storage.thickness[this->edge_idx(edge)]; }
     void process_edge_neighbors(const VD::edge_type* edge, ThickPolyline* polyline);
     bool validate_edge(const VD::edge_type* edge);
     const Line& retrieve_segment(const VD::cell_type* cell) const;
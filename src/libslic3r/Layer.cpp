@@ -171,14 +171,14 @@ void Layer::make_perimeters()
     BOOST_LOG_TRIVIAL(trace) << "Generating perimeters for layer " << this->id() << " - Done";
 }
 
-void Layer::make_fills()
+void Layer::make_fills(FillPool *fill_pool)
 {
     #ifdef SLIC3R_DEBUG
     printf("Making fills for layer " PRINTF_ZU "\n", this->id());
     #endif
     for (LayerRegion *layerm : m_regions) {
         layerm->fills.clear();
-        make_fill(*layerm, layerm->fills);
+        make_fill(*layerm, layerm->fills, fill_pool);
 #ifndef NDEBUG
         for (size_t i = 0; i < layerm->fills.entities.size(); ++ i)
             assert(dynamic_cast<ExtrusionEntityCollection*>(layerm->fills.entities[i]) != NULL);
@@ -14,6 +14,7 @@ namespace Slic3r {
 class Layer;
 class PrintRegion;
 class PrintObject;
+class FillPool;
 
 class LayerRegion
 {
@@ -135,7 +136,8 @@ public:
         return false;
     }
     void                    make_perimeters();
-    void                    make_fills();
+    // The Fill objects may be reused across the layers filled by the same thread.
+    void                    make_fills(FillPool *fill_pool = nullptr);
 
     void                    export_region_slices_to_svg(const char *path) const;
     void                    export_region_fill_surfaces_to_svg(const char *path) const;
@@ -21,6 +21,11 @@ MotionPlanner::MotionPlanner(const ExPolygons &islands) : m_initialized(false)
             m_islands.emplace_back(MotionPlannerEnv(island));
         expp.clear();
     }
+    std::vector<const ExPolygon*> islands_ptrs;
+    islands_ptrs.reserve(m_islands.size());
+    for (const MotionPlannerEnv &island : m_islands)
+        islands_ptrs.emplace_back(&island.m_island);
+    m_islands_index.create(islands_ptrs);
 }
 
 void MotionPlanner::initialize()
@@ -50,6 +55,9 @@ void MotionPlanner::initialize()
     // from Clipper data structure into the Slic3r expolygons inside diff_ex().
     m_outer = MotionPlannerEnv(outer.front());
     m_outer.m_env = ExPolygonCollection(diff_ex(contour, offset(outer_holes, +MP_OUTER_MARGIN)));
+    // grow our environment slightly in order for simplify_by_visibility()
+    // to work best by considering moves on boundaries valid as well
+    m_outer_env_grown = ExPolygonCollection(offset_ex(m_outer.m_env.expolygons, float(+SCALED_EPSILON)));
     m_graphs.resize(m_islands.size() + 1);
     m_initialized = true;
 }
@@ -61,25 +69,19 @@ Polyline MotionPlanner::shortest_path(const Point &from, const Point &to)
         return Polyline(from, to);
     
     // Are both points in the same island?
-    int island_idx_from = -1;
-    int island_idx_to   = -1;
+    int island_idx_from = this->island_containing(from);
+    int island_idx_to   = this->island_containing(to);
     int island_idx      = -1;
-    for (MotionPlannerEnv &island : m_islands) {
-        int idx = &island - m_islands.data();
-        if (island.island_contains(from))
-            island_idx_from = idx;
-        if (island.island_contains(to))
-            island_idx_to   = idx;
-        if (island_idx_from == idx && island_idx_to == idx) {
-            // Since both points are in the same island, is a direct move possible?
-            // If so, we avoid generating the visibility environment.
-            if (island.m_island.contains(Line(from, to)))
-                return Polyline(from, to);
-            // Both points are inside a single island, but the straight line crosses the island boundary.
-            island_idx = idx;
-            break;
-        }
-    }
+    if (island_idx_from != -1 && island_idx_from == island_idx_to) {
+        // Since both points are in the same island, is a direct move possible?
+        // If so, we avoid generating the visibility environment.
+        if (m_islands[island_idx_from].m_island.contains(Line(from, to)))
+            return Polyline(from, to);
+        // Both points are inside a single island, but the straight line crosses the island boundary.
+        island_idx = island_idx_from;
+    } else if (island_idx_from == -1 && island_idx_to == -1 && ! this->crosses_islands(Line(from, to)))
+        // Both points are outside of the islands and a direct move does not cross any of them.
+        return Polyline(from, to);
     
     // lazy generation of configuration space.
     this->initialize();
@@ -121,11 +123,8 @@ Polyline MotionPlanner::shortest_path(const Point &from, const Point &to)
     polyline.points.emplace_back(to);
     
     {
-        // grow our environment slightly in order for simplify_by_visibility()
-        // to work best by considering moves on boundaries valid as well
-        ExPolygonCollection grown_env(offset_ex(env.m_env.expolygons, float(+SCALED_EPSILON)));
-        
         if (island_idx == -1) {
+            const ExPolygonCollection &grown_env = m_outer_env_grown;
             /*  If 'from' or 'to' are not inside our env, they were connected using the 
                 nearest_env_point() search which maybe produce ugly paths since it does not
                 include the endpoint in the Dijkstra search; the simplify_by_visibility() 
@@ -178,6 +177,24 @@ Polyline MotionPlanner::shortest_path(const Point &from, const Point &to)
     return polyline;
 }
 
+// Does the line cross a contour or a hole of any island?
+bool MotionPlanner::crosses_islands(const Line &line) const
+{
+    BoundingBox bbox(line.a, line.a);
+    bbox.merge(line.b);
+    return m_islands_index.visit_overlapping(bbox, [this, &line](size_t idx) {
+        const ExPolygon &island = m_islands[idx].m_island;
+        Point ip;
+        for (size_t i = 0; i <= island.holes.size(); ++ i) {
+            const Points &pts = (i == 0) ? island.contour.points : island.holes[i - 1].points;
+            for (size_t j = 0; j < pts.size(); ++ j)
+                if (Line(pts[j], pts[(j + 1 == pts.size()) ? 0 : j + 1]).intersection(line, &ip))
+                    return true;
+        }
+        return false;
+    });
+}
+
 const MotionPlannerGraph& MotionPlanner::init_graph(int island_idx)
 {
     // 0th graph is the graph for m_outer. Other graphs are 1 indexed.
@@ -304,7 +321,8 @@ void MotionPlannerGraph::add_edge(size_t from, size_t to, double weight)
     m_adjacency_list[from].emplace_back(Neighbor(node_t(to), weight));
 }
 
-// Dijkstra's shortest path in a weighted graph from node_start to node_end.
+// A* shortest path in a weighted graph from node_start to node_end, guided by the Euclidean distance to node_end.
+// The edge weights are Euclidean lengths, therefore the heuristic is consistent and the path found is the shortest one.
 // The returned path contains the end points.
 // If no path exists from node_start to node_end, a straight segment is returned.
 Polyline MotionPlannerGraph::shortest_path(size_t node_start, size_t node_end) const
@@ -313,37 +331,47 @@ Polyline MotionPlannerGraph::shortest_path(size_t node_start, size_t node_end) c
     if (this->empty())
         return Polyline();
 
-    // Dijkstra algorithm, previous node of the current node 'u' in the shortest path towards node_start.
-    std::vector<node_t>   previous(m_adjacency_list.size(), -1);
-    std::vector<weight_t> distance(m_adjacency_list.size(), std::numeric_limits<weight_t>::infinity());
-    std::vector<size_t>   map_node_to_queue_id(m_adjacency_list.size(), size_t(-1));
+    // Previous node of the current node 'u' in the shortest path towards node_start.
+    std::vector<node_t>   previous(m_nodes.size(), -1);
+    std::vector<weight_t> distance(m_nodes.size(), std::numeric_limits<weight_t>::infinity());
+    // Distance from node_start plus the estimated distance to node_end.
+    std::vector<weight_t> estimate(m_nodes.size(), std::numeric_limits<weight_t>::infinity());
+    // Position of a node in the queue, size_t(-1) for the nodes not reached yet, size_t(-2) for the nodes already visited.
+    std::vector<size_t>   map_node_to_queue_id(m_nodes.size(), size_t(-1));
+    const size_t          visited = size_t(-2);
+    const Vec2d           target  = m_nodes[node_end].cast<double>();
     distance[node_start] = 0.;
+    estimate[node_start] = (target - m_nodes[node_start].cast<double>()).norm();
 
     auto queue = make_mutable_priority_queue<node_t>(
         [&map_node_to_queue_id](const node_t node, size_t idx) { map_node_to_queue_id[node] = idx; },
-        [&distance](const node_t node1, const node_t node2) { return distance[node1] < distance[node2]; });
-    queue.reserve(m_adjacency_list.size());
-    for (size_t i = 0; i < m_adjacency_list.size(); ++ i)
-        queue.push(node_t(i));
+        [&estimate](const node_t node1, const node_t node2) { return estimate[node1] < estimate[node2]; });
+    queue.push(node_t(node_start));
 
     while (! queue.empty()) {
-        // Get the next node with the lowest distance to node_start.
+        // Get the next node with the lowest estimate of the path length through it.
         node_t u = node_t(queue.top());
         queue.pop();
-        map_node_to_queue_id[u] = size_t(-1);
+        map_node_to_queue_id[u] = visited;
         // Stop searching if we reached our destination.
         if (u == node_end)
             break;
+        if (size_t(u) >= m_adjacency_list.size())
+            continue;
         // Visit each edge starting at node u.
         for (const Neighbor& neighbor : m_adjacency_list[u])
-            if (map_node_to_queue_id[neighbor.target] != size_t(-1)) {
+            if (map_node_to_queue_id[neighbor.target] != visited) {
                 weight_t alt = distance[u] + neighbor.weight;
                 // If total distance through u is shorter than the previous
                 // distance (if any) between node_start and neighbor.target, replace it.
                 if (alt < distance[neighbor.target]) {
                     distance[neighbor.target] = alt;
+                    estimate[neighbor.target] = alt + (target - m_nodes[neighbor.target].cast<double>()).norm();
                     previous[neighbor.target] = u;
-                    queue.update(map_node_to_queue_id[neighbor.target]);
+                    if (map_node_to_queue_id[neighbor.target] == size_t(-1))
+                        queue.push(neighbor.target);
+                    else
+                        queue.update(map_node_to_queue_id[neighbor.target]);
                 }
             }
     }
@@ -351,7 +379,6 @@ Polyline MotionPlannerGraph::shortest_path(size_t node_start, size_t node_end) c
     // In case the end point was not reached, previous[node_end] contains -1
     // and a straight line from node_start to node_end is returned.
     Polyline polyline;
-    polyline.points.reserve(m_adjacency_list.size());
     for (node_t vertex = node_t(node_end); vertex != -1; vertex = previous[vertex])
         polyline.points.emplace_back(m_nodes[vertex]);
     polyline.points.emplace_back(m_nodes[node_start]);
@@ -38,7 +38,7 @@ private:
     ExPolygonCollection m_env;
 };
 
-// A 2D directed graph for searching a shortest path using the famous Dijkstra algorithm.
+// A 2D directed graph for searching a shortest path using the A* algorithm.
 class MotionPlannerGraph
 {    
 public:
@@ -68,6 +68,9 @@ class MotionPlanner
 {
 public:
     MotionPlanner(const ExPolygons &islands);
+    // m_islands_index points to m_islands.
+    MotionPlanner(const MotionPlanner &) = delete;
+    MotionPlanner& operator=(const MotionPlanner &) = delete;
     ~MotionPlanner() {}
 
     Polyline    shortest_path(const Point &from, const Point &to);
@@ -76,11 +79,18 @@ public:
 private:
     bool                                m_initialized;
     std::vector<MotionPlannerEnv>       m_islands;
+    // Spatial index over m_islands.
+    ExPolygonsIndex                     m_islands_index;
     MotionPlannerEnv                    m_outer;
+    // m_outer.m_env grown by SCALED_EPSILON, to accept the moves along its boundary.
+    ExPolygonCollection                 m_outer_env_grown;
     // 0th graph is the graph for m_outer. Other graphs are 1 indexed.
     std::vector<std::unique_ptr<MotionPlannerGraph>> m_graphs;
     
     void                      initialize();
+    int                       island_containing(const Point &pt) const
+        { size_t idx = m_islands_index.find_containing(pt); return (idx == size_t(-1)) ? -1 : int(idx); }
+    bool                      crosses_islands(const Line &line) const;
     const MotionPlannerGraph& init_graph(int island_idx);
     const MotionPlannerEnv&   get_env(int island_idx) const
         { return (island_idx == -1) ? m_outer : m_islands[island_idx]; }
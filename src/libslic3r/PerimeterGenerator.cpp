@@ -4,8 +4,34 @@
 #include <cmath>
 #include <cassert>
 
+#include <tbb/parallel_for.h>
+
 namespace Slic3r {
 
+// Calculate medial axes of independent ExPolygons (thin walls or gaps of a single island) in parallel.
+// The result is ordered the same way as if the medial axes were calculated sequentially.
+static void medial_axis_parallel(const ExPolygons &expolygons, double max_width, double min_width, ThickPolylines &out)
+{
+    if (expolygons.size() < 2) {
+        for (const ExPolygon &ex : expolygons)
+            ex.medial_axis(max_width, min_width, &out);
+        return;
+    }
+    std::vector<ThickPolylines> polylines(expolygons.size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, expolygons.size()),
+        [&expolygons, &polylines, max_width, min_width](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i)
+                expolygons[i].medial_axis(max_width, min_width, &polylines[i]);
+        });
+    size_t n = out.size();
+    for (const ThickPolylines &pp : polylines)
+        n += pp.size();
+    out.reserve(n);
+    for (ThickPolylines &pp : polylines)
+        std::move(pp.begin(), pp.end(), std::back_inserter(out));
+}
+
 void PerimeterGenerator::process()
 {
     // other perimeters
@@ -47,9 +73,16 @@ void PerimeterGenerator::process()
         this->_lower_slices_p = offset(*this->lower_slices, float(scale_(+nozzle_diameter/2)));
     }
     
+    // Outputs of a single island, merged into the outputs of this PerimeterGenerator in the order of the islands.
+    struct IslandOutput {
+        ExtrusionEntityCollection loops;
+        ExtrusionEntityCollection gap_fill;
+        ExPolygons                fill_expolygons;
+    };
+
     // we need to process each island separately because we might have different
     // extra perimeters for each one
-    for (const Surface &surface : this->slices->surfaces) {
+    auto process_island = [&](const Surface &surface, IslandOutput &out) {
         // detect how many perimeters must be generated for this island
         int        loop_number = this->config->perimeters + surface.extra_perimeters - 1;  // 0-indexed loops
         ExPolygons last        = union_ex(surface.expolygon.simplify_p(SCALED_RESOLUTION));
@@ -84,8 +117,7 @@ void PerimeterGenerator::process()
                                     true),
                             - min_width / 2, min_width / 2);
                         // the maximum thickness of our thin wall area is equal to the minimum thickness of a single loop
-                        for (ExPolygon &ex : expp)
-                            ex.medial_axis(ext_perimeter_width + ext_perimeter_spacing2, min_width, &thin_walls);
+                        medial_axis_parallel(expp, ext_perimeter_width + ext_perimeter_spacing2, min_width, thin_walls);
                     }
                 } else {
                     //FIXME Is this offset correct if the line width of the inner perimeters differs
@@ -196,9 +228,9 @@ void PerimeterGenerator::process()
             if (this->config->external_perimeters_first || 
                 (this->layer_id == 0 && this->print_config->brim_width.value > 0))
                 entities.reverse();
-            // append perimeters for this slice as a collection
+            // perimeters for this slice as a collection
             if (! entities.empty())
-                this->loops->append(entities);
+                out.loops = std::move(entities);
         } // for each loop of an island
 
         // fill gaps
@@ -212,12 +244,11 @@ void PerimeterGenerator::process()
                 offset2_ex(gaps, -max/2, +max/2),
                 true);
             ThickPolylines polylines;
-            for (const ExPolygon &ex : gaps_ex)
-                ex.medial_axis(max, min, &polylines);
+            medial_axis_parallel(gaps_ex, max, min, polylines);
             if (! polylines.empty()) {
                 ExtrusionEntityCollection gap_fill = this->_variable_width(polylines, 
                     erGapFill, this->solid_infill_flow);
-                this->gap_fill->append(gap_fill.entities);
+                out.gap_fill.append(gap_fill.entities);
                 /*  Make sure we don't infill narrow parts that are already gap-filled
                     (we only consider this surface's gaps to reduce the diff() complexity).
                     Growing actual extrusions ensures that gaps not filled by medial axis
@@ -251,13 +282,34 @@ void PerimeterGenerator::process()
         // collapse too narrow infill areas
         coord_t min_perimeter_infill_spacing = solid_infill_spacing * (1. - INSET_OVERLAP_TOLERANCE);
         // append infill areas to fill_surfaces
-        this->fill_surfaces->append(
-            offset2_ex(
-                union_ex(pp),
-                - inset - min_perimeter_infill_spacing / 2,
-                min_perimeter_infill_spacing / 2),
-            stInternal);
-    } // for each island
+        out.fill_expolygons = offset2_ex(
+            union_ex(pp),
+            - inset - min_perimeter_infill_spacing / 2,
+            min_perimeter_infill_spacing / 2);
+    };
+
+    // The islands are independent. A layer with many islands (a first layer, a plate full of small objects) is processed
+    // in parallel, nested into the parallel processing of the layers, so that the cores are not left idle at the last layers.
+    const Surfaces            &surfaces = this->slices->surfaces;
+    std::vector<IslandOutput> islands(surfaces.size());
+    if (surfaces.size() < 2) {
+        for (size_t i = 0; i < surfaces.size(); ++ i)
+            process_island(surfaces[i], islands[i]);
+    } else {
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, surfaces.size()),
+            [&surfaces, &islands, &process_island](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++ i)
+                    process_island(surfaces[i], islands[i]);
+            });
+    }
+    for (IslandOutput &island : islands) {
+        // append perimeters for this slice as a collection
+        if (! island.loops.empty())
+            this->loops->entities.push_back(new ExtrusionEntityCollection(std::move(island.loops)));
+        this->gap_fill->append(std::move(island.gap_fill.entities));
+        this->fill_surfaces->append(std::move(island.fill_expolygons), stInternal);
+    }
 }
 
 ExtrusionEntityCollection PerimeterGenerator::_traverse_loops(
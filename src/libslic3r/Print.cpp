@@ -13,10 +13,14 @@
 #include "PrintExport.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <limits>
+#include <sstream>
 #include <unordered_set>
 #include <boost/filesystem/path.hpp>
 #include <boost/log/trivial.hpp>
+#include <tbb/task_group.h>
 
 //! macro used to mark string used at localization, 
 //! return same string
@@ -130,6 +134,8 @@ bool Print::invalidate_state_by_config_options(const std::vector<t_config_option
         "gcode_label_objects",
         "infill_acceleration",
         "layer_gcode",
+        "layer_wavefront",
+        "low_memory",
         "min_fan_speed",
         "max_fan_speed",
         "max_print_height",
@@ -158,6 +164,8 @@ bool Print::invalidate_state_by_config_options(const std::vector<t_config_option
         "retract_restart_extra_toolchange",
         "retract_speed",
         "single_extruder_multi_material_priming",
+        "slice_cache",
+        "slice_cache_size",
         "slowdown_below_layer_time",
         "standby_temperature_delta",
         "start_gcode",
@@ -653,6 +661,125 @@ static std::vector<PrintInstances> print_objects_from_model_object(const ModelOb
     return std::vector<PrintInstances>(trafos.begin(), trafos.end());
 }
 
+// 64bit FNV-1a hash of the vertices of a mesh.
+static uint64_t mesh_hash(const TriangleMesh &mesh)
+{
+    uint64_t h = 14695981039346656037ull;
+    for (uint32_t i = 0; i < mesh.stl.stats.number_of_facets; ++ i) {
+        const unsigned char *p = (const unsigned char*)mesh.stl.facet_start[i].vertex;
+        for (size_t j = 0; j < 3 * sizeof(stl_vertex); ++ j) {
+            h ^= uint64_t(p[j]);
+            h *= 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+static bool meshes_identical(const TriangleMesh &lhs, const TriangleMesh &rhs)
+{
+    if (lhs.stl.stats.number_of_facets != rhs.stl.stats.number_of_facets)
+        return false;
+    for (uint32_t i = 0; i < lhs.stl.stats.number_of_facets; ++ i)
+        if (memcmp(lhs.stl.facet_start[i].vertex, rhs.stl.facet_start[i].vertex, 3 * sizeof(stl_vertex)) != 0)
+            return false;
+    return true;
+}
+
+static inline bool configs_identical(const DynamicPrintConfig &lhs, const DynamicPrintConfig &rhs)
+{
+    return lhs.keys() == rhs.keys() && lhs.equals(rhs);
+}
+
+// Will the two ModelObjects be printed with the same settings, and are their volumes placed identically?
+// The meshes of the volumes are compared by print_objects_from_model_objects().
+static bool model_objects_identical(const ModelObject &lhs, const ModelObject &rhs)
+{
+    if (lhs.volumes.size() != rhs.volumes.size())
+        return false;
+    // Cheap tests first.
+    for (size_t i = 0; i < lhs.volumes.size(); ++ i) {
+        const ModelVolume &vl = *lhs.volumes[i];
+        const ModelVolume &vr = *rhs.volumes[i];
+        if (vl.type() != vr.type() || vl.mesh.stl.stats.number_of_facets != vr.mesh.stl.stats.number_of_facets ||
+            vl.material_id() != vr.material_id() || ! transform3d_equal(vl.get_matrix(), vr.get_matrix()))
+            return false;
+    }
+    if (lhs.layer_height_ranges != rhs.layer_height_ranges || lhs.layer_height_profile != rhs.layer_height_profile || 
+        ! configs_identical(lhs.config, rhs.config))
+        return false;
+    for (size_t i = 0; i < lhs.volumes.size(); ++ i)
+        if (! configs_identical(lhs.volumes[i]->config, rhs.volumes[i]->config))
+            return false;
+    return true;
+}
+
+// Generate a list of trafos and XY offsets for instances of all ModelObjects.
+// Geometrically identical ModelObjects printed with the same settings (for example pasted or imported multiple times)
+// are folded into the first of them, so that they will be printed by the same PrintObjects as its copies
+// and they will be sliced just once. The instance lists of the folded ModelObjects are left empty.
+// The mesh hashes and the pairs of ModelVolumes verified to have identical meshes are cached over the calls
+// by their ModelVolume IDs, only the entries of the ModelVolumes of the current call are retained.
+static std::vector<std::vector<PrintInstances>> print_objects_from_model_objects(
+    const ModelObjectPtrs &model_objects, std::map<ModelID, uint64_t> &mesh_hashes, std::set<std::pair<ModelID, ModelID>> &identical_meshes)
+{
+    std::vector<std::vector<PrintInstances>> out(model_objects.size());
+    std::vector<size_t>                      representatives;
+    std::map<ModelID, uint64_t>              mesh_hashes_new;
+    std::set<std::pair<ModelID, ModelID>>    identical_meshes_new;
+    auto volume_mesh_hash = [&mesh_hashes, &mesh_hashes_new](const ModelVolume &model_volume) {
+        auto it = mesh_hashes_new.find(model_volume.id());
+        if (it == mesh_hashes_new.end()) {
+            auto it_old = mesh_hashes.find(model_volume.id());
+            it = mesh_hashes_new.emplace(model_volume.id(), (it_old == mesh_hashes.end()) ? mesh_hash(model_volume.mesh) : it_old->second).first;
+        }
+        return it->second;
+    };
+    // The meshes are only compared in full if their hashes match and if they were not verified to be identical before.
+    auto volume_meshes_identical = [&identical_meshes, &identical_meshes_new, &volume_mesh_hash](const ModelVolume &lhs, const ModelVolume &rhs) {
+        std::pair<ModelID, ModelID> key(lhs.id(), rhs.id());
+        if (identical_meshes_new.find(key) != identical_meshes_new.end())
+            return true;
+        if (volume_mesh_hash(lhs) != volume_mesh_hash(rhs) || 
+            (identical_meshes.find(key) == identical_meshes.end() && ! meshes_identical(lhs.mesh, rhs.mesh)))
+            return false;
+        identical_meshes_new.insert(key);
+        return true;
+    };
+    for (size_t idx_object = 0; idx_object < model_objects.size(); ++ idx_object) {
+        const ModelObject          &model_object = *model_objects[idx_object];
+        std::vector<PrintInstances> instances    = print_objects_from_model_object(model_object);
+        if (instances.empty())
+            continue;
+        auto it_representative = std::find_if(representatives.begin(), representatives.end(), 
+            [&model_objects, &model_object, &volume_meshes_identical](size_t idx) {
+                const ModelObject &representative = *model_objects[idx];
+                if (! model_objects_identical(representative, model_object))
+                    return false;
+                for (size_t i = 0; i < model_object.volumes.size(); ++ i)
+                    if (! volume_meshes_identical(*representative.volumes[i], *model_object.volumes[i]))
+                        return false;
+                return true;
+            });
+        if (it_representative == representatives.end()) {
+            representatives.emplace_back(idx_object);
+            out[idx_object] = std::move(instances);
+        } else {
+            // Merge the instances into the representative, keep the list sorted by the trafos.
+            std::vector<PrintInstances> &dst = out[*it_representative];
+            for (PrintInstances &src : instances) {
+                auto it = std::lower_bound(dst.begin(), dst.end(), src);
+                if (it != dst.end() && transform3d_equal(it->trafo, src.trafo))
+                    append(it->copies, std::move(src.copies));
+                else
+                    dst.insert(it, std::move(src));
+            }
+        }
+    }
+    mesh_hashes      = std::move(mesh_hashes_new);
+    identical_meshes = std::move(identical_meshes_new);
+    return out;
+}
+
 Print::ApplyStatus Print::apply(const Model &model, const DynamicPrintConfig &config_in)
 {
 #ifdef _DEBUG
@@ -911,8 +1038,11 @@ Print::ApplyStatus Print::apply(const Model &model, const DynamicPrintConfig &co
         std::vector<PrintObject*> print_objects_new;
         print_objects_new.reserve(std::max(m_objects.size(), m_model.objects.size()));
         bool new_objects = false;
+        // Generate a list of trafos and XY offsets for instances of all ModelObjects, fold the identical ModelObjects.
+        std::vector<std::vector<PrintInstances>> model_objects_print_instances = print_objects_from_model_objects(m_model.objects, m_mesh_hashes, m_identical_meshes);
         // Walk over all new model objects and check, whether there are matching PrintObjects.
-        for (ModelObject *model_object : m_model.objects) {
+        for (size_t idx_model_object = 0; idx_model_object < m_model.objects.size(); ++ idx_model_object) {
+            ModelObject *model_object = m_model.objects[idx_model_object];
             auto range = print_object_status.equal_range(PrintObjectStatus(model_object->id()));
             std::vector<const PrintObjectStatus*> old;
             if (range.first != range.second) {
@@ -921,9 +1051,9 @@ Print::ApplyStatus Print::apply(const Model &model, const DynamicPrintConfig &co
                     if (it->status != PrintObjectStatus::Deleted)
                         old.emplace_back(&(*it));
             }
-            // Generate a list of trafos and XY offsets for instances of a ModelObject
             PrintObjectConfig config = PrintObject::object_config_from_model_object(m_default_object_config, *model_object, num_extruders);
-            std::vector<PrintInstances> new_print_instances = print_objects_from_model_object(*model_object);
+            // Empty for a ModelObject folded into another ModelObject, its old PrintObjects will be deleted.
+            const std::vector<PrintInstances> &new_print_instances = model_objects_print_instances[idx_model_object];
             if (old.empty()) {
                 // Simple case, just generate new instances.
                 for (const PrintInstances &print_instances : new_print_instances) {
@@ -1046,7 +1176,7 @@ Print::ApplyStatus Print::apply(const Model &model, const DynamicPrintConfig &co
                 region.config_apply_only(this_region_config, diff, false);
                 for (PrintObject *print_object : m_objects)
                     if (region_id < print_object->region_volumes.size() && ! print_object->region_volumes[region_id].empty())
-                        update_apply_status(print_object->invalidate_state_by_config_options(diff));
+                        update_apply_status(print_object->invalidate_state_by_config_options(diff, int(region_id)));
             }
         }
     }
@@ -1104,6 +1234,10 @@ Print::ApplyStatus Print::apply(const Model &model, const DynamicPrintConfig &co
         }
     }
 
+    // Low memory mode: The steps to be executed may need the data released after the previous run.
+    for (PrintObject *object : m_objects)
+        update_apply_status(object->invalidate_released_data());
+
     // Update SlicingParameters for each object where the SlicingParameters is not valid.
     // If it is not valid, then it is ensured that PrintObject.m_slicing_params is not in use
     // (posSlicing and posSupportMaterial was invalidated).
@@ -1471,43 +1605,158 @@ void Print::auto_assign_extruders(ModelObject* model_object) const
 }
 
 // Slicing process, running at a background thread.
+void Print::set_object_status(int percent, const std::string &message)
+{
+    int last = m_object_status_percent.load();
+    while (percent > last)
+        if (m_object_status_percent.compare_exchange_weak(last, percent)) {
+            this->set_status(percent, message);
+            break;
+        }
+}
+
+// Run the tasks concurrently, rethrow the first exception thrown by a task after all the tasks finished.
+// The tasks catch their exceptions, because an exception escaping a task would cancel the task group and with it
+// the parallel loops nested inside the other tasks. These loops would return early without an error,
+// leaving the steps of the other tasks with partial results to be marked as done.
+static void run_concurrently(const std::vector<std::function<void()>> &tasks)
+{
+    std::exception_ptr  exception;
+    tbb::mutex          exception_mutex;
+    tbb::task_group     group;
+    for (const std::function<void()> &task : tasks)
+        group.run([&task, &exception, &exception_mutex]() {
+            try {
+                task();
+            } catch (...) {
+                tbb::mutex::scoped_lock lock(exception_mutex);
+                if (! exception)
+                    exception = std::current_exception();
+            }
+        });
+    group.wait();
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
 void Print::process()
 {
     BOOST_LOG_TRIVIAL(info) << "Staring the slicing process." << log_memory_info();
+    m_object_status_percent = 0;
+    // The PrintObjects do not depend on each other, therefore they are processed concurrently.
+    // The steps of a single PrintObject are performed in sequence, each step depends on the previous ones:
+    // posSlice, posPerimeters, posPrepareInfill, posInfill and posSupportMaterial, which avoids the bridging perimeters and infill.
+    std::vector<std::function<void()>> object_tasks;
     for (PrintObject *obj : m_objects)
-        obj->make_perimeters();
-    this->set_status(70, "Infilling layers");
-    for (PrintObject *obj : m_objects)
-        obj->infill();
-    for (PrintObject *obj : m_objects)
-        obj->generate_support_material();
-    if (this->set_started(psSkirt)) {
-        m_skirt.clear();
-        if (this->has_skirt()) {
-            this->set_status(88, "Generating skirt");
-            this->_make_skirt();
+        object_tasks.emplace_back([this, obj]() {
+            obj->make_perimeters();
+            this->set_object_status(70, "Infilling layers");
+            obj->infill();
+            obj->generate_support_material();
+            if (m_config.low_memory)
+                obj->release_intermediate_data();
+        });
+    run_concurrently(object_tasks);
+    // The skirt and brim depend on all the PrintObjects, but not on each other.
+    // The wipe tower is generated afterwards, as it inserts layers into the support layers of the first PrintObject,
+    // which are read by the skirt and brim.
+    run_concurrently({ [this]() {
+        if (this->set_started(psSkirt)) {
+            m_skirt.clear();
+            if (this->has_skirt()) {
+                this->set_status(88, "Generating skirt");
+                this->_make_skirt();
+            }
+            this->set_step_counter(psSkirt, "extrusions", m_skirt.items_count());
+            this->set_done(psSkirt);
         }
-        this->set_done(psSkirt);
-    }
-	if (this->set_started(psBrim)) {
-        m_brim.clear();
-        if (m_config.brim_width > 0) {
-            this->set_status(88, "Generating brim");
-            this->_make_brim();
+    }, [this]() {
+        if (this->set_started(psBrim)) {
+            m_brim.clear();
+            if (m_config.brim_width > 0) {
+                this->set_status(88, "Generating brim");
+                this->_make_brim();
+            }
+            this->set_step_counter(psBrim, "extrusions", m_brim.items_count());
+            this->set_done(psBrim);
         }
-       this->set_done(psBrim);
-    }
+    } });
     if (this->set_started(psWipeTower)) {
         m_wipe_tower_data.clear();
         if (this->has_wipe_tower()) {
             //this->set_status(95, "Generating wipe tower");
             this->_make_wipe_tower();
+            if (m_wipe_tower_data.number_of_toolchanges > 0)
+                this->set_step_counter(psWipeTower, "toolchanges", size_t(m_wipe_tower_data.number_of_toolchanges));
         }
-       this->set_done(psWipeTower);
+        this->set_done(psWipeTower);
     }
     BOOST_LOG_TRIVIAL(info) << "Slicing process finished." << log_memory_info();
 }
 
+static std::string json_quoted(const std::string &str)
+{
+    std::string out = "\"";
+    for (char c : str) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                char buf[8];
+                sprintf(buf, "\\u%04x", int(c));
+                out += buf;
+            } else
+                out += c;
+        }
+    }
+    return out + "\"";
+}
+
+static void step_statistics_to_json(std::ostringstream &out, const char *step_name, const PrintStepStatistics &stats, const std::string &indent)
+{
+    out << indent << json_quoted(step_name) << ": { \"done\": " << (stats.valid ? "true" : "false");
+    if (stats.valid) {
+        out << ", \"wall_time\": " << stats.wall_time
+            << ", \"cpu_time\": " << stats.cpu_time
+            << ", \"thread_utilization\": " << stats.thread_utilization()
+            << ", \"peak_rss_delta\": " << stats.peak_rss_delta
+            << ", \"counters\": {";
+        for (auto it = stats.counters.begin(); it != stats.counters.end(); ++ it)
+            out << (it == stats.counters.begin() ? " " : ", ") << json_quoted(it->first) << ": " << it->second;
+        out << (stats.counters.empty() ? "}" : " }");
+    }
+    out << " }";
+}
+
+std::string Print::step_statistics_json() const
+{
+    static const char *print_step_names[psCount]         = { "skirt", "brim", "wipe_tower", "gcode_export" };
+    static const char *print_object_step_names[posCount] = { "slice", "perimeters", "prepare_infill", "infill", "support_material" };
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out << "{\n  \"print\": {\n";
+    for (size_t step = 0; step < psCount; ++ step) {
+        step_statistics_to_json(out, print_step_names[step], this->step_statistics(PrintStep(step)), "    ");
+        out << ((step + 1 < psCount) ? ",\n" : "\n");
+    }
+    out << "  },\n  \"objects\": [";
+    for (size_t idx_object = 0; idx_object < m_objects.size(); ++ idx_object) {
+        const PrintObject *object = m_objects[idx_object];
+        out << ((idx_object == 0) ? "\n" : ",\n") << "    {\n      \"name\": " << json_quoted(object->model_object()->name) << ",\n";
+        for (size_t step = 0; step < posCount; ++ step) {
+            step_statistics_to_json(out, print_object_step_names[step], object->step_statistics(PrintObjectStep(step)), "      ");
+            out << ((step + 1 < posCount) ? ",\n" : "\n");
+        }
+        out << "    }";
+    }
+    out << (m_objects.empty() ? "]\n}\n" : "\n  ]\n}\n");
+    return out.str();
+}
+
 // G-code export process, running at a background thread.
 // The export_gcode may die for various reasons (fails to process output_filename_format,
 // write error into the G-code, cannot execute post-processing scripts).
@@ -12,6 +12,10 @@
 #include "GCode/ToolOrdering.hpp"
 #include "GCode/WipeTower.hpp"
 
+#include <atomic>
+#include <map>
+#include <set>
+
 namespace Slic3r {
 
 class Print;
@@ -122,6 +126,8 @@ public:
     SupportLayer* add_support_layer(int id, coordf_t height, coordf_t print_z);
     SupportLayerPtrs::const_iterator insert_support_layer(SupportLayerPtrs::const_iterator pos, int id, coordf_t height, coordf_t print_z, coordf_t slice_z);
     void delete_support_layer(int idx);
+    // Low memory mode: Release the extrusions of an object layer and of a support layer after they were exported to G-code.
+    void release_extrusions(const Layer *layer, const SupportLayer *support_layer);
     
     // Initialize the layer_height_profile from the model_object's layer_height_profile, from model_object's layer height table, or from slicing parameters.
     // Returns true, if the layer_height_profile was changed.
@@ -160,7 +166,9 @@ protected:
     // Invalidates all PrintObject and Print steps.
     bool                    invalidate_all_steps();
     // Invalidate steps based on a set of parameters changed.
-    bool                    invalidate_state_by_config_options(const std::vector<t_config_option_key> &opt_keys);
+    // If the parameters of a single region changed (region_id >= 0) and only the infill step is affected,
+    // just the layers containing the region are scheduled to be filled again.
+    bool                    invalidate_state_by_config_options(const std::vector<t_config_option_key> &opt_keys, int region_id = -1);
     // If ! m_slicing_params.valid, recalculate.
     void                    update_slicing_parameters();
 
@@ -172,18 +180,29 @@ private:
     void prepare_infill();
     void infill();
     void generate_support_material();
+    // Low memory mode: Release the data of the layers, which are not needed by the G-code export.
+    void release_intermediate_data();
+    // Low memory mode: Invalidate the steps producing the released data if they are needed again.
+    bool invalidate_released_data();
 
     void _slice(const std::vector<coordf_t> &layer_height_profile);
     std::string _fix_slicing_errors();
     void _simplify_slices(double distance);
     void _make_perimeters();
+    void make_perimeters_wavefront();
+    bool has_extra_perimeters(size_t region_id) const;
+    void make_extra_perimeters(size_t region_id, size_t layer_idx);
     bool has_support_material() const;
+    std::vector<std::pair<coordf_t, coordf_t>> region_z_ranges(size_t region_id) const;
+    bool infill_dirty(const Layer &layer) const;
     void detect_surfaces_type();
+    void detect_surfaces_type(size_t idx_region, size_t idx_layer, bool interface_shells, Surfaces &surfaces_out);
     void process_external_surfaces();
     void discover_vertical_shells();
     void bridge_over_infill();
     void clip_fill_surfaces();
     void discover_horizontal_shells();
+    void discover_horizontal_shells(size_t region_id);
     void combine_infill();
     void _generate_support_material();
 
@@ -200,10 +219,20 @@ private:
     SlicingParameters                       m_slicing_params;
     LayerPtrs                               m_layers;
     SupportLayerPtrs                        m_support_layers;
+    // Set by make_perimeters_wavefront(), which already performed the first half of prepare_infill().
+    bool                                    m_external_surfaces_processed = false;
+    // Z ranges (print_z of the bottommost and topmost layer) of the layers to be filled by the next run of the infill step.
+    // Empty if the infill step shall process all the layers. Only read by the background processing, cleared by invalidate_step().
+    std::vector<std::pair<coordf_t, coordf_t>> m_infill_dirty_ranges;
+    // Low memory mode: The fill surfaces and other intermediate data were released after the object was processed.
+    bool                                    m_intermediate_data_released = false;
+    // Low memory mode: The extrusions of some layers were released by the G-code export.
+    bool                                    m_extrusions_released = false;
 
     std::vector<ExPolygons> _slice_region(size_t region_id, const std::vector<float> &z, bool modifier);
     std::vector<ExPolygons> _slice_volumes(const std::vector<float> &z, const std::vector<const ModelVolume*> &volumes) const;
     std::vector<ExPolygons> _slice_volume(const std::vector<float> &z, const ModelVolume &volume) const;
+    void _slice_mesh(TriangleMesh &mesh, const std::vector<float> &z, std::vector<ExPolygons> &layers) const;
 };
 
 struct WipeTowerData
@@ -346,6 +375,12 @@ public:
     const ExtrusionEntityCollection& brim() const { return m_brim; }
 
     const PrintStatistics&      print_statistics() const { return m_print_statistics; }
+    // Low memory mode releases the extrusions of the layers as soon as they are exported to G-code.
+    // The GUI keeps them, as its G-code preview reads the extrusions of the objects while the G-code is being exported.
+    void                        set_keep_extrusions(bool keep) { m_keep_extrusions = keep; }
+    bool                        release_extrusions_on_export() const { return m_config.low_memory.value && ! m_keep_extrusions; }
+    // Time, memory and item counts of the last run of the Print and PrintObject steps, formatted as JSON.
+    std::string                 step_statistics_json() const;
 
     // Wipe tower support.
     bool                        has_wipe_tower() const;
@@ -368,6 +403,10 @@ protected:
 private:
     bool                invalidate_state_by_config_options(const std::vector<t_config_option_key> &opt_keys);
 
+    // Status update from the steps of a PrintObject. The PrintObjects are processed concurrently,
+    // therefore the update is only reported if it advances the progress.
+    void                set_object_status(int percent, const std::string &message);
+
     void                _make_skirt();
     void                _make_brim();
     void                _make_wipe_tower();
@@ -392,6 +431,15 @@ private:
     // Estimated print time, filament consumed.
     PrintStatistics                         m_print_statistics;
 
+    // The highest progress reported by set_object_status() during the current process() call.
+    std::atomic<int>                        m_object_status_percent { 0 };
+    // See set_keep_extrusions().
+    bool                                    m_keep_extrusions = false;
+    // Folding of the identical ModelObjects by apply(): Hashes of the meshes of the ModelVolumes
+    // and the pairs of ModelVolumes with identical meshes, identified by their IDs.
+    std::map<ModelID, uint64_t>             m_mesh_hashes;
+    std::set<std::pair<ModelID, ModelID>>   m_identical_meshes;
+
     // To allow GCode to set the Print's GCodeExport step status.
     friend class GCode;
     // Allow PrintObject to access m_mutex and m_cancel_callback.
@@ -4,6 +4,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include "I18N.hpp"
+#include "Utils.hpp"
 
 //! macro used to mark string used at localization, 
 //! return same string
@@ -14,6 +15,24 @@ namespace Slic3r
 
 size_t PrintStateBase::g_last_timestamp = 0;
 
+void PrintStepStatistics::start()
+{
+    this->valid             = false;
+    this->counters.clear();
+    m_wall_time_start       = std::chrono::steady_clock::now();
+    m_cpu_time_start        = get_cpu_time();
+    m_peak_rss_start        = get_peak_rss();
+}
+
+void PrintStepStatistics::stop()
+{
+    this->wall_time         = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_wall_time_start).count();
+    this->cpu_time          = get_cpu_time() - m_cpu_time_start;
+    size_t peak_rss         = get_peak_rss();
+    this->peak_rss_delta    = (peak_rss > m_peak_rss_start) ? peak_rss - m_peak_rss_start : 0;
+    this->valid             = true;
+}
+
 // Update "scale", "input_filename", "input_filename_base" placeholders from the current m_objects.
 void PrintBase::update_object_placeholders(DynamicConfig &config) const
 {
@@ -2,6 +2,8 @@
 #define slic3r_PrintBase_hpp_
 
 #include "libslic3r.h"
+#include <chrono>
+#include <map>
 #include <set>
 #include <vector>
 #include <string>
@@ -49,6 +51,34 @@ protected:
     static size_t g_last_timestamp;
 };
 
+// Resources consumed by the last run of a Print / PrintObject step, recorded by PrintState::set_started() / set_done().
+class PrintStepStatistics
+{
+public:
+    // Was the step finished, so that the values below are valid?
+    bool                            valid           = false;
+    // Wall clock time in seconds.
+    double                          wall_time       = 0.;
+    // CPU time of the whole process while the step was running, in seconds.
+    // The steps of different PrintObjects may run concurrently, then their CPU times overlap.
+    double                          cpu_time        = 0.;
+    // Growth of the peak resident memory of the process while the step was running, in bytes.
+    size_t                          peak_rss_delta  = 0;
+    // Number of items produced by the step, for example layers, polygons, extrusions or G-code bytes.
+    std::map<std::string, size_t>   counters;
+
+    // Average number of threads busy while the step was running.
+    double                          thread_utilization() const { return (wall_time > 0.) ? cpu_time / wall_time : 0.; }
+
+    void                            start();
+    void                            stop();
+
+private:
+    std::chrono::steady_clock::time_point   m_wall_time_start;
+    double                                  m_cpu_time_start        = 0.;
+    size_t                                  m_peak_rss_start        = 0;
+};
+
 // To be instantiated over PrintStep or PrintObjectStep enums.
 template <class StepType, size_t COUNT>
 class PrintState : public PrintStateBase
@@ -95,6 +125,7 @@ public:
             return false;
         m_state[step].state = STARTED;
         m_state[step].timestamp = ++ g_last_timestamp;
+        m_statistics[step].start();
         return true;
     }
 
@@ -108,9 +139,21 @@ public:
         assert(m_state[step].state != DONE);
         m_state[step].state = DONE;
         m_state[step].timestamp = ++ g_last_timestamp;
+        m_statistics[step].stop();
         return m_state[step].timestamp;
     }
 
+    PrintStepStatistics statistics(StepType step, tbb::mutex &mtx) const {
+        tbb::mutex::scoped_lock lock(mtx);
+        return m_statistics[step];
+    }
+
+    // Record a number of items produced by a running step.
+    void set_counter(StepType step, const std::string &name, size_t value, tbb::mutex &mtx) {
+        tbb::mutex::scoped_lock lock(mtx);
+        m_statistics[step].counters[name] = value;
+    }
+
     // Make the step invalid.
     // PrintBase::m_state_mutex should be locked at this point, guarding access to m_state.
     // In case the step has already been entered or finished, cancel the background
@@ -182,7 +225,8 @@ public:
     }
 
 private:
-    StateWithTimeStamp m_state[COUNT];
+    StateWithTimeStamp  m_state[COUNT];
+    PrintStepStatistics m_statistics[COUNT];
 };
 
 class PrintBase;
@@ -362,10 +406,13 @@ class PrintBaseWithState : public PrintBase
 public:
     bool            is_step_done(PrintStepEnum step) const { return m_state.is_done(step, this->state_mutex()); }
 	PrintStateBase::StateWithTimeStamp step_state_with_timestamp(PrintStepEnum step) const { return m_state.state_with_timestamp(step, this->state_mutex()); }
+    // Time and memory consumed by the last run of a step.
+    PrintStepStatistics step_statistics(PrintStepEnum step) const { return m_state.statistics(step, this->state_mutex()); }
 
 protected:
     bool            set_started(PrintStepEnum step) { return m_state.set_started(step, this->state_mutex(), [this](){ this->throw_if_canceled(); }); }
 	PrintStateBase::TimeStamp set_done(PrintStepEnum step) { return m_state.set_done(step, this->state_mutex(), [this](){ this->throw_if_canceled(); }); }
+    void            set_step_counter(PrintStepEnum step, const std::string &name, size_t value) { m_state.set_counter(step, name, value, this->state_mutex()); }
     bool            invalidate_step(PrintStepEnum step)
 		{ return m_state.invalidate(step, this->cancel_callback()); }
     template<typename StepTypeIterator>
@@ -393,6 +440,8 @@ public:
     typedef PrintState<PrintObjectStepEnum, COUNT> PrintObjectState;
     bool            is_step_done(PrintObjectStepEnum step) const { return m_state.is_done(step, PrintObjectBase::state_mutex(m_print)); }
     PrintStateBase::StateWithTimeStamp step_state_with_timestamp(PrintObjectStepEnum step) const { return m_state.state_with_timestamp(step, PrintObjectBase::state_mutex(m_print)); }
+    // Time and memory consumed by the last run of a step.
+    PrintStepStatistics step_statistics(PrintObjectStepEnum step) const { return m_state.statistics(step, PrintObjectBase::state_mutex(m_print)); }
 
 protected:
 	PrintObjectBaseWithState(PrintType *print, ModelObject *model_object) : PrintObjectBase(model_object), m_print(print) {}
@@ -401,6 +450,8 @@ protected:
         { return m_state.set_started(step, PrintObjectBase::state_mutex(m_print), [this](){ this->throw_if_canceled(); }); }
 	PrintStateBase::TimeStamp set_done(PrintObjectStepEnum step) 
         { return m_state.set_done(step, PrintObjectBase::state_mutex(m_print), [this](){ this->throw_if_canceled(); }); }
+    void            set_step_counter(PrintObjectStepEnum step, const std::string &name, size_t value)
+        { m_state.set_counter(step, name, value, PrintObjectBase::state_mutex(m_print)); }
 
     bool            invalidate_step(PrintObjectStepEnum step)
         { return m_state.invalidate(step, PrintObjectBase::cancel_callback(m_print)); }
@@ -1026,6 +1026,15 @@ void PrintConfigDef::init_fff_params()
     def->mode = comExpert;
     def->default_value = new ConfigOptionBool(false);
 
+    def = this->add("layer_wavefront", coBool);
+    def->label = L("Layer wavefront processing");
+    def->tooltip = L("Experimental: Instead of finishing the perimeters of all layers before the infill is being prepared, "
+                   "start preparing the infill of a layer as soon as the perimeters of the layer and of the layer below "
+                   "are finished. The result is the same, the layers are processed in a different order.");
+    def->category = L("Layers and Perimeters");
+    def->mode = comExpert;
+    def->default_value = new ConfigOptionBool(false);
+
     def = this->add("layer_gcode", coString);
     def->label = L("After layer change G-code");
     def->tooltip = L("This custom code is inserted at every layer change, right after the Z move "
@@ -1038,6 +1047,38 @@ void PrintConfigDef::init_fff_params()
     def->mode = comExpert;
     def->default_value = new ConfigOptionString("");
 
+    def = this->add("low_memory", coBool);
+    def->label = L("Low memory mode");
+    def->tooltip = L("Experimental: Release the intermediate data of the objects as soon as they are not needed anymore "
+                   "and release the extrusions of the layers as soon as they are exported to G-code "
+                   "(the extrusions are only released by the command line Slic3r, the G-code preview needs them). "
+                   "This lowers the peak memory consumption when slicing large prints, "
+                   "but any following change of the print settings requires the objects to be processed again.");
+    def->category = L("Advanced");
+    def->mode = comExpert;
+    def->default_value = new ConfigOptionBool(false);
+
+    def = this->add("slice_cache", coString);
+    def->label = L("Slice cache directory");
+    def->tooltip = L("Experimental: Directory to store the slices of the objects to. The slices are looked up by a hash "
+                   "of the object geometry, its placement and the layer heights, so that an object already sliced before "
+                   "is not sliced again if only the settings not affecting the slicing have changed. "
+                   "Leave empty to disable the cache.");
+    def->category = L("Advanced");
+    def->mode = comExpert;
+    def->default_value = new ConfigOptionString("");
+
+    def = this->add("slice_cache_size", coInt);
+    def->label = L("Slice cache size limit");
+    def->tooltip = L("Maximum size of the slice cache directory. Whenever new slices are stored into the cache "
+                   "and the cache exceeds this size, the least recently used slices are deleted. "
+                   "Set to zero to let the cache grow without limit, then the cache directory has to be cleaned up manually.");
+    def->sidetext = L("MB");
+    def->category = L("Advanced");
+    def->min = 0;
+    def->mode = comExpert;
+    def->default_value = new ConfigOptionInt(1024);
+
     def = this->add("remaining_times", coBool);
     def->label = L("Supports remaining times");
     def->tooltip = L("Emit M73 P[percent printed] R[remaining time in minutes] at 1 minute"
@@ -3093,6 +3134,10 @@ CLIMiscConfigDef::CLIMiscConfigDef()
     def->label = L("Data directory");
     def->tooltip = L("Load and store settings at the given directory. This is useful for maintaining different profiles or including configurations from a network storage.");
 
+    def = this->add("statistics", coString);
+    def->label = L("Step statistics file");
+    def->tooltip = L("Write the time, memory and the number of items produced by the individual slicing steps to the specified JSON file.");
+
     def = this->add("loglevel", coInt);
     def->label = L("Logging level");
     def->tooltip = L("Messages with severity lower or eqal to the loglevel will be printed out. 0:trace, 1:debug, 2:info, 3:warning, 4:error, 5:fatal");
@@ -760,6 +760,8 @@ public:
     ConfigOptionInts                first_layer_temperature;
     ConfigOptionFloat               infill_acceleration;
     ConfigOptionBool                infill_first;
+    ConfigOptionBool                layer_wavefront;
+    ConfigOptionBool                low_memory;
     ConfigOptionInts                max_fan_speed;
     ConfigOptionFloats              max_layer_height;
     ConfigOptionInts                min_fan_speed;
@@ -782,6 +784,8 @@ public:
     ConfigOptionFloat               skirt_distance;
     ConfigOptionInt                 skirt_height;
     ConfigOptionInt                 skirts;
+    ConfigOptionString              slice_cache;
+    ConfigOptionInt                 slice_cache_size;
     ConfigOptionInts                slowdown_below_layer_time;
     ConfigOptionBool                spiral_vase;
     ConfigOptionInt                 standby_temperature_delta;
@@ -832,6 +836,8 @@ protected:
         OPT_PTR(first_layer_temperature);
         OPT_PTR(infill_acceleration);
         OPT_PTR(infill_first);
+        OPT_PTR(layer_wavefront);
+        OPT_PTR(low_memory);
         OPT_PTR(max_fan_speed);
         OPT_PTR(max_layer_height);
         OPT_PTR(min_fan_speed);
@@ -854,6 +860,8 @@ protected:
         OPT_PTR(skirt_distance);
         OPT_PTR(skirt_height);
         OPT_PTR(skirts);
+        OPT_PTR(slice_cache);
+        OPT_PTR(slice_cache_size);
         OPT_PTR(slowdown_below_layer_time);
         OPT_PTR(spiral_vase);
         OPT_PTR(standby_temperature_delta);
@@ -3,10 +3,13 @@
 #include "ClipperUtils.hpp"
 #include "Geometry.hpp"
 #include "SupportMaterial.hpp"
+#include "SliceCache.hpp"
 #include "Surface.hpp"
 #include "Slicing.hpp"
 #include "Utils.hpp"
+#include "Fill/Fill.hpp"
 
+#include <atomic>
 #include <utility>
 #include <boost/log/trivial.hpp>
 #include <float.h>
@@ -14,6 +17,8 @@
 #include <tbb/task_scheduler_init.h>
 #include <tbb/parallel_for.h>
 #include <tbb/atomic.h>
+#include <tbb/task_group.h>
+#include <tbb/enumerable_thread_specific.h>
 
 #include <Shiny/Shiny.h>
 
@@ -89,6 +94,26 @@ PrintBase::ApplyStatus PrintObject::set_copies(const Points &points)
     return status;
 }
 
+// Number of polygons (contours and holes) of the layer slices, to be recorded by the step statistics.
+static size_t count_slice_polygons(const LayerPtrs &layers)
+{
+    size_t n = 0;
+    for (const Layer *layer : layers)
+        for (const ExPolygon &expoly : layer->slices.expolygons)
+            n += expoly.holes.size() + 1;
+    return n;
+}
+
+// Number of extrusions of the layer regions, to be recorded by the step statistics.
+static size_t count_region_extrusions(const LayerPtrs &layers, ExtrusionEntityCollection LayerRegion::*extrusions)
+{
+    size_t n = 0;
+    for (const Layer *layer : layers)
+        for (const LayerRegion *layerm : layer->regions())
+            n += (layerm->*extrusions).items_count();
+    return n;
+}
+
 // 1) Decides Z positions of the layers,
 // 2) Initializes layers and their regions
 // 3) Slices the object meshes
@@ -102,7 +127,7 @@ void PrintObject::slice()
 {
     if (! this->set_started(posSlice))
         return;
-    m_print->set_status(10, "Processing triangulated mesh");
+    m_print->set_object_status(10, "Processing triangulated mesh");
     std::vector<coordf_t> layer_height_profile;
     this->update_layer_height_profile(*this->model_object(), m_slicing_params, layer_height_profile);
     m_print->throw_if_canceled();
@@ -119,6 +144,8 @@ void PrintObject::slice()
         this->_simplify_slices(scale_(this->print()->config().resolution));
     if (m_layers.empty())
         throw std::runtime_error("No layers were detected. You might want to repair your STL file(s) or check their size or thickness and retry.\n");    
+    this->set_step_counter(posSlice, "layers", m_layers.size());
+    this->set_step_counter(posSlice, "polygons", count_slice_polygons(m_layers));
     this->set_done(posSlice);
 }
 
@@ -133,7 +160,7 @@ void PrintObject::make_perimeters()
     if (! this->set_started(posPerimeters))
         return;
 
-    m_print->set_status(20, "Generating perimeters");
+    m_print->set_object_status(20, "Generating perimeters");
     BOOST_LOG_TRIVIAL(info) << "Generating perimeters..." << log_memory_info();
     
     // merge slices if they were split into types
@@ -145,89 +172,47 @@ void PrintObject::make_perimeters()
         this->typed_slices = false;
     }
     
-    // compare each layer to the one below, and mark those slices needing
-    // one additional inner perimeter, like the top of domed objects-
-    
-    // this algorithm makes sure that at least one perimeter is overlapping
-    // but we don't generate any extra perimeter if fill density is zero, as they would be floating
-    // inside the object - infill_only_where_needed should be the method of choice for printing
-    // hollow objects
-    for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
-        const PrintRegion &region = *m_print->regions()[region_id];
-        if (! region.config().extra_perimeters || region.config().perimeters == 0 || region.config().fill_density == 0 || this->layer_count() < 2)
-            continue;
+    if (m_print->config().layer_wavefront.value && ! m_config.interface_shells.value) {
+        this->make_perimeters_wavefront();
+    } else {
+        // compare each layer to the one below, and mark those slices needing
+        // one additional inner perimeter, like the top of domed objects-
         
-        BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - start";
+        // this algorithm makes sure that at least one perimeter is overlapping
+        // but we don't generate any extra perimeter if fill density is zero, as they would be floating
+        // inside the object - infill_only_where_needed should be the method of choice for printing
+        // hollow objects
+        for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
+            if (! this->has_extra_perimeters(region_id))
+                continue;
+            
+            BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - start";
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, m_layers.size() - 1),
+                [this, region_id](const tbb::blocked_range<size_t>& range) {
+                    for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                        m_print->throw_if_canceled();
+                        this->make_extra_perimeters(region_id, layer_idx);
+                    }
+                });
+            m_print->throw_if_canceled();
+            BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - end";
+        }
+
+        BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start";
         tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, m_layers.size() - 1),
-            [this, &region, region_id](const tbb::blocked_range<size_t>& range) {
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this](const tbb::blocked_range<size_t>& range) {
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                     m_print->throw_if_canceled();
-                    LayerRegion &layerm                     = *m_layers[layer_idx]->m_regions[region_id];
-                    const LayerRegion &upper_layerm         = *m_layers[layer_idx+1]->m_regions[region_id];
-                    const Polygons upper_layerm_polygons    = upper_layerm.slices;
-                    // Filter upper layer polygons in intersection_ppl by their bounding boxes?
-                    // my $upper_layerm_poly_bboxes= [ map $_->bounding_box, @{$upper_layerm_polygons} ];
-                    const double total_loop_length      = total_length(upper_layerm_polygons);
-                    const coord_t perimeter_spacing     = layerm.flow(frPerimeter).scaled_spacing();
-                    const Flow ext_perimeter_flow       = layerm.flow(frExternalPerimeter);
-                    const coord_t ext_perimeter_width   = ext_perimeter_flow.scaled_width();
-                    const coord_t ext_perimeter_spacing = ext_perimeter_flow.scaled_spacing();
-
-                    for (Surface &slice : layerm.slices.surfaces) {
-                        for (;;) {
-                            // compute the total thickness of perimeters
-                            const coord_t perimeters_thickness = ext_perimeter_width/2 + ext_perimeter_spacing/2
-                                + (region.config().perimeters-1 + slice.extra_perimeters) * perimeter_spacing;
-                            // define a critical area where we don't want the upper slice to fall into
-                            // (it should either lay over our perimeters or outside this area)
-                            const coord_t critical_area_depth = coord_t(perimeter_spacing * 1.5);
-                            const Polygons critical_area = diff(
-                                offset(slice.expolygon, float(- perimeters_thickness)),
-                                offset(slice.expolygon, float(- perimeters_thickness - critical_area_depth))
-                            );
-                            // check whether a portion of the upper slices falls inside the critical area
-                            const Polylines intersection = intersection_pl(to_polylines(upper_layerm_polygons), critical_area);
-                            // only add an additional loop if at least 30% of the slice loop would benefit from it
-                            if (total_length(intersection) <=  total_loop_length*0.3)
-                                break;
-                            /*
-                            if (0) {
-                                require "Slic3r/SVG.pm";
-                                Slic3r::SVG::output(
-                                    "extra.svg",
-                                    no_arrows   => 1,
-                                    expolygons  => union_ex($critical_area),
-                                    polylines   => [ map $_->split_at_first_point, map $_->p, @{$upper_layerm->slices} ],
-                                );
-                            }
-                            */
-                            ++ slice.extra_perimeters;
-                        }
-                        #ifdef DEBUG
-                            if (slice.extra_perimeters > 0)
-                                printf("  adding %d more perimeter(s) at layer %zu\n", slice.extra_perimeters, layer_idx);
-                        #endif
-                    }
+                    m_layers[layer_idx]->make_perimeters();
                 }
-            });
+            }
+        );
         m_print->throw_if_canceled();
-        BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - end";
+        BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - end";
     }
 
-    BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start";
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
-        [this](const tbb::blocked_range<size_t>& range) {
-            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
-                m_print->throw_if_canceled();
-                m_layers[layer_idx]->make_perimeters();
-            }
-        }
-    );
-    m_print->throw_if_canceled();
-    BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - end";
-
     /*
         simplify slices (both layer and region slices),
         we only need the max resolution for perimeters
@@ -235,44 +220,237 @@ void PrintObject::make_perimeters()
     ###$self->_simplify_slices(&Slic3r::SCALED_RESOLUTION);
     */
     
+    this->set_step_counter(posPerimeters, "extrusions", 
+        count_region_extrusions(m_layers, &LayerRegion::perimeters) + count_region_extrusions(m_layers, &LayerRegion::thin_fills));
     this->set_done(posPerimeters);
 }
 
+bool PrintObject::has_extra_perimeters(size_t region_id) const
+{
+    const PrintRegionConfig &config = m_print->regions()[region_id]->config();
+    return config.extra_perimeters && config.perimeters > 0 && config.fill_density > 0 && this->layer_count() >= 2;
+}
+
+// Compare the region slices of a layer to the region slices of the layer above, and increase
+// the number of perimeters of those slices, which would otherwise leave the upper perimeters hanging in the air.
+// Reads the untyped region slices of layer_idx + 1, writes the region slices of layer_idx.
+void PrintObject::make_extra_perimeters(size_t region_id, size_t layer_idx)
+{
+    const PrintRegion &region = *m_print->regions()[region_id];
+    LayerRegion &layerm                     = *m_layers[layer_idx]->m_regions[region_id];
+    const LayerRegion &upper_layerm         = *m_layers[layer_idx+1]->m_regions[region_id];
+    const Polygons upper_layerm_polygons    = upper_layerm.slices;
+    const double total_loop_length      = total_length(upper_layerm_polygons);
+    // Only add an additional loop if at least 30% of the slice loop would benefit from it.
+    const double min_intersection_length = total_loop_length * 0.3;
+    // Index the upper layer slices in a uniform grid, so that only the loops of the upper slices overlapping a slice
+    // are visited and clipped by its critical area. upper_layerm_polygons contains the contour and the holes
+    // of each upper slice, upper_layerm_first_loop[i] is the index of the contour of the i-th upper slice.
+    const Polylines          upper_layerm_polylines = to_polylines(upper_layerm_polygons);
+    std::vector<BoundingBox> upper_layerm_bboxes    = get_extents_vector(upper_layerm_polygons);
+    std::vector<double>      upper_layerm_lengths;
+    upper_layerm_lengths.reserve(upper_layerm_polylines.size());
+    for (const Polyline &polyline : upper_layerm_polylines)
+        upper_layerm_lengths.emplace_back(polyline.length());
+    std::vector<const ExPolygon*> upper_layerm_expolygons;
+    std::vector<size_t>           upper_layerm_first_loop;
+    upper_layerm_expolygons.reserve(upper_layerm.slices.surfaces.size());
+    upper_layerm_first_loop.reserve(upper_layerm.slices.surfaces.size() + 1);
+    upper_layerm_first_loop.emplace_back(0);
+    for (const Surface &surface : upper_layerm.slices.surfaces) {
+        upper_layerm_expolygons.emplace_back(&surface.expolygon);
+        upper_layerm_first_loop.emplace_back(upper_layerm_first_loop.back() + surface.expolygon.holes.size() + 1);
+    }
+    assert(upper_layerm_first_loop.back() == upper_layerm_polylines.size());
+    ExPolygonsIndex upper_layerm_index;
+    upper_layerm_index.create(upper_layerm_expolygons);
+    const coord_t perimeter_spacing     = layerm.flow(frPerimeter).scaled_spacing();
+    const Flow ext_perimeter_flow       = layerm.flow(frExternalPerimeter);
+    const coord_t ext_perimeter_width   = ext_perimeter_flow.scaled_width();
+    const coord_t ext_perimeter_spacing = ext_perimeter_flow.scaled_spacing();
+
+    std::vector<size_t> candidates;
+    Polylines           candidate_polylines;
+    for (Surface &slice : layerm.slices.surfaces) {
+        // The critical area is inside the slice, therefore only the upper loops overlapping the slice may intersect it.
+        BoundingBox slice_bbox = get_extents(slice.expolygon.contour);
+        double      candidates_length = 0.;
+        candidates.clear();
+        upper_layerm_index.visit_overlapping(slice_bbox, [&](size_t idx_expolygon) {
+            for (size_t i = upper_layerm_first_loop[idx_expolygon]; i < upper_layerm_first_loop[idx_expolygon + 1]; ++ i)
+                if (upper_layerm_bboxes[i].overlap(slice_bbox))
+                    candidates.emplace_back(i);
+            return false;
+        });
+        // Keep the order of the loops independent of the grid.
+        std::sort(candidates.begin(), candidates.end());
+        for (size_t i : candidates)
+            candidates_length += upper_layerm_lengths[i];
+        for (;;) {
+            // The intersection with the critical area can not be longer than the candidate loops.
+            if (candidates_length <= min_intersection_length)
+                break;
+            // compute the total thickness of perimeters
+            const coord_t perimeters_thickness = ext_perimeter_width/2 + ext_perimeter_spacing/2
+                + (region.config().perimeters-1 + slice.extra_perimeters) * perimeter_spacing;
+            // define a critical area where we don't want the upper slice to fall into
+            // (it should either lay over our perimeters or outside this area)
+            const coord_t critical_area_depth = coord_t(perimeter_spacing * 1.5);
+            const Polygons outer = offset(slice.expolygon, float(- perimeters_thickness));
+            if (outer.empty())
+                break;
+            // The slice only shrinks with the growing number of extra perimeters,
+            // drop the candidate loops, which are out of reach of the shrunk slice.
+            {
+                BoundingBox outer_bbox = get_extents(outer);
+                size_t      j          = 0;
+                candidates_length = 0.;
+                for (size_t i : candidates)
+                    if (upper_layerm_bboxes[i].overlap(outer_bbox)) {
+                        candidates[j ++] = i;
+                        candidates_length += upper_layerm_lengths[i];
+                    }
+                candidates.resize(j);
+                if (candidates_length <= min_intersection_length)
+                    break;
+            }
+            const Polygons critical_area = diff(outer, offset(slice.expolygon, float(- perimeters_thickness - critical_area_depth)));
+            // check whether a portion of the upper slices falls inside the critical area
+            candidate_polylines.clear();
+            for (size_t i : candidates)
+                candidate_polylines.emplace_back(upper_layerm_polylines[i]);
+            const Polylines intersection = intersection_pl(candidate_polylines, critical_area);
+            // only add an additional loop if at least 30% of the slice loop would benefit from it
+            if (total_length(intersection) <= min_intersection_length)
+                break;
+            /*
+            if (0) {
+                require "Slic3r/SVG.pm";
+                Slic3r::SVG::output(
+                    "extra.svg",
+                    no_arrows   => 1,
+                    expolygons  => union_ex($critical_area),
+                    polylines   => [ map $_->split_at_first_point, map $_->p, @{$upper_layerm->slices} ],
+                );
+            }
+            */
+            ++ slice.extra_perimeters;
+        }
+        #ifdef DEBUG
+            if (slice.extra_perimeters > 0)
+                printf("  adding %d more perimeter(s) at layer %zu\n", slice.extra_perimeters, layer_idx);
+        #endif
+    }
+}
+
+// Wavefront variant of the perimeter generation, enabled by the layer_wavefront option.
+// The perimeters of the layers are generated in parallel as before, but as soon as the perimeters of a layer
+// and of the layer below are finished, the surfaces of the layer are classified (detect_surfaces_type()),
+// its fill surfaces are prepared and its external surfaces are processed, while the perimeters
+// of the upper layers are still being generated. prepare_infill() then skips these steps.
+// The layer dependencies are the same as with the step by step processing, therefore the result is the same:
+// 1) The extra perimeters of layer N read the untyped region slices of layer N + 1.
+// 2) Classification of layer N replaces the region slices of layer N and it needs the fill_expolygons
+//    produced by the perimeter generator of layer N.
+// 3) Classification of layer N only reads the layer slices of layers N - 1 and N + 1, which are not being modified.
+// Not used with interface_shells, which makes the classification read the region slices of the neighbor layers.
+void PrintObject::make_perimeters_wavefront()
+{
+    const size_t num_layers  = m_layers.size();
+    const size_t num_regions = this->region_volumes.size();
+    std::vector<size_t> extra_perimeter_regions;
+    for (size_t region_id = 0; region_id < num_regions; ++ region_id)
+        if (this->has_extra_perimeters(region_id))
+            extra_perimeter_regions.emplace_back(region_id);
+
+    // Number of perimeter tasks, which have to finish before the surfaces of a layer may be classified:
+    // The perimeters of the layer itself and of the layer below.
+    std::vector<std::atomic<int>> num_pending(num_layers);
+    for (size_t layer_idx = 0; layer_idx < num_layers; ++ layer_idx)
+        num_pending[layer_idx] = (layer_idx == 0) ? 1 : 2;
+
+    BOOST_LOG_TRIVIAL(debug) << "Generating perimeters and processing external surfaces in a layer wavefront - start";
+    tbb::task_group task_group;
+    auto classify_layer = [this, num_regions](size_t layer_idx) {
+        Layer *layer       = m_layers[layer_idx];
+        Layer *lower_layer = (layer_idx == 0) ? nullptr : m_layers[layer_idx - 1];
+        for (size_t region_id = 0; region_id < num_regions; ++ region_id) {
+            m_print->throw_if_canceled();
+            LayerRegion *layerm = layer->m_regions[region_id];
+            this->detect_surfaces_type(region_id, layer_idx, false, layerm->slices.surfaces);
+            layerm->slices_to_fill_surfaces_clipped();
+            layerm->prepare_fill_surfaces();
+            layerm->process_external_surfaces(lower_layer);
+        }
+    };
+    auto perimeters_done = [&task_group, &num_pending, &classify_layer](size_t layer_idx) {
+        if (-- num_pending[layer_idx] == 0)
+            task_group.run([&classify_layer, layer_idx]() { classify_layer(layer_idx); });
+    };
+    task_group.run([this, num_layers, &extra_perimeter_regions, &perimeters_done]() {
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, num_layers),
+            [this, num_layers, &extra_perimeter_regions, &perimeters_done](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                    m_print->throw_if_canceled();
+                    if (layer_idx + 1 < num_layers)
+                        for (size_t region_id : extra_perimeter_regions)
+                            this->make_extra_perimeters(region_id, layer_idx);
+                    m_layers[layer_idx]->make_perimeters();
+                    perimeters_done(layer_idx);
+                    if (layer_idx + 1 < num_layers)
+                        perimeters_done(layer_idx + 1);
+                }
+            });
+    });
+    task_group.wait();
+    m_print->throw_if_canceled();
+    BOOST_LOG_TRIVIAL(debug) << "Generating perimeters and processing external surfaces in a layer wavefront - end";
+
+    this->typed_slices = true;
+    m_external_surfaces_processed = true;
+}
+
 void PrintObject::prepare_infill()
 {
     if (! this->set_started(posPrepareInfill))
         return;
 
-    m_print->set_status(30, "Preparing infill");
+    m_print->set_object_status(30, "Preparing infill");
 
-    // This will assign a type (top/bottom/internal) to $layerm->slices.
-    // Then the classifcation of $layerm->slices is transfered onto 
-    // the $layerm->fill_surfaces by clipping $layerm->fill_surfaces
-    // by the cummulative area of the previous $layerm->fill_surfaces.
-    this->detect_surfaces_type();
-    m_print->throw_if_canceled();
+    if (m_external_surfaces_processed) {
+        // The surfaces were classified and the external surfaces processed layer by layer by make_perimeters_wavefront().
+        m_external_surfaces_processed = false;
+    } else {
+        // This will assign a type (top/bottom/internal) to $layerm->slices.
+        // Then the classifcation of $layerm->slices is transfered onto 
+        // the $layerm->fill_surfaces by clipping $layerm->fill_surfaces
+        // by the cummulative area of the previous $layerm->fill_surfaces.
+        this->detect_surfaces_type();
+        m_print->throw_if_canceled();
     
-    // Decide what surfaces are to be filled.
-    // Here the S_TYPE_TOP / S_TYPE_BOTTOMBRIDGE / S_TYPE_BOTTOM infill is turned to just S_TYPE_INTERNAL if zero top / bottom infill layers are configured.
-    // Also tiny S_TYPE_INTERNAL surfaces are turned to S_TYPE_INTERNAL_SOLID.
-    BOOST_LOG_TRIVIAL(info) << "Preparing fill surfaces..." << log_memory_info();
-    for (auto *layer : m_layers)
-        for (auto *region : layer->m_regions) {
-            region->prepare_fill_surfaces();
-            m_print->throw_if_canceled();
-        }
+        // Decide what surfaces are to be filled.
+        // Here the S_TYPE_TOP / S_TYPE_BOTTOMBRIDGE / S_TYPE_BOTTOM infill is turned to just S_TYPE_INTERNAL if zero top / bottom infill layers are configured.
+        // Also tiny S_TYPE_INTERNAL surfaces are turned to S_TYPE_INTERNAL_SOLID.
+        BOOST_LOG_TRIVIAL(info) << "Preparing fill surfaces..." << log_memory_info();
+        for (auto *layer : m_layers)
+            for (auto *region : layer->m_regions) {
+                region->prepare_fill_surfaces();
+                m_print->throw_if_canceled();
+            }
 
-    // this will detect bridges and reverse bridges
-    // and rearrange top/bottom/internal surfaces
-    // It produces enlarged overlapping bridging areas.
-    //
-    // 1) S_TYPE_BOTTOMBRIDGE / S_TYPE_BOTTOM infill is grown by 3mm and clipped by the total infill area. Bridges are detected. The areas may overlap.
-    // 2) S_TYPE_TOP is grown by 3mm and clipped by the grown bottom areas. The areas may overlap.
-    // 3) Clip the internal surfaces by the grown top/bottom surfaces.
-    // 4) Merge surfaces with the same style. This will mostly get rid of the overlaps.
-    //FIXME This does not likely merge surfaces, which are supported by a material with different colors, but same properties.
-    this->process_external_surfaces();
-    m_print->throw_if_canceled();
+        // this will detect bridges and reverse bridges
+        // and rearrange top/bottom/internal surfaces
+        // It produces enlarged overlapping bridging areas.
+        //
+        // 1) S_TYPE_BOTTOMBRIDGE / S_TYPE_BOTTOM infill is grown by 3mm and clipped by the total infill area. Bridges are detected. The areas may overlap.
+        // 2) S_TYPE_TOP is grown by 3mm and clipped by the grown bottom areas. The areas may overlap.
+        // 3) Clip the internal surfaces by the grown top/bottom surfaces.
+        // 4) Merge surfaces with the same style. This will mostly get rid of the overlaps.
+        //FIXME This does not likely merge surfaces, which are supported by a material with different colors, but same properties.
+        this->process_external_surfaces();
+        m_print->throw_if_canceled();
+    }
 
     // Add solid fills to ensure the shell vertical thickness.
     this->discover_vertical_shells();
@@ -350,6 +528,13 @@ void PrintObject::prepare_infill()
     } // for each layer
 #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
 
+    {
+        size_t num_fill_surfaces = 0;
+        for (const Layer *layer : m_layers)
+            for (const LayerRegion *layerm : layer->regions())
+                num_fill_surfaces += layerm->fill_surfaces.surfaces.size();
+        this->set_step_counter(posPrepareInfill, "fill_surfaces", num_fill_surfaces);
+    }
     this->set_done(posPrepareInfill);
 }
 
@@ -359,31 +544,160 @@ void PrintObject::infill()
     this->prepare_infill();
 
     if (this->set_started(posInfill)) {
+        // A region of a layer with the same fill surfaces as the region of the layer one infill pattern period below
+        // gets a copy of the infill of that layer instead of being filled again. This is typical for the sparse infill
+        // of the prismatic parts of tall objects.
+        const size_t        num_regions = this->region_volumes.size();
+        std::vector<size_t> fill_periods(num_regions, 0);
+        for (size_t region_id = 0; region_id < num_regions; ++ region_id)
+            if (! this->region_volumes[region_id].empty())
+                fill_periods[region_id] = fill_layer_period(m_print->regions()[region_id]->config());
+        // For each layer and region, index of the layer to copy the infill from.
+        std::vector<size_t> fill_sources(m_layers.size() * num_regions);
+        BOOST_LOG_TRIVIAL(debug) << "Filling layers - searching for repeating fill surfaces in parallel - start";
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this, num_regions, &fill_periods, &fill_sources](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                    m_print->throw_if_canceled();
+                    for (size_t region_id = 0; region_id < num_regions; ++ region_id) {
+                        size_t  period = fill_periods[region_id];
+                        size_t &source = fill_sources[layer_idx * num_regions + region_id];
+                        source = (period > 0 && layer_idx >= period && 
+                                  fill_repeats(*m_layers[layer_idx - period]->regions()[region_id], *m_layers[layer_idx]->regions()[region_id], period)) ?
+                            layer_idx - period : layer_idx;
+                    }
+                }
+            }
+        );
+        m_print->throw_if_canceled();
+        BOOST_LOG_TRIVIAL(debug) << "Filling layers - searching for repeating fill surfaces in parallel - end";
+        // Copy from the bottom most layer of a run of repeating layers.
+        size_t num_copies = 0;
+        for (size_t i = 0; i < fill_sources.size(); ++ i)
+            if (fill_sources[i] != i / num_regions) {
+                fill_sources[i] = fill_sources[fill_sources[i] * num_regions + i % num_regions];
+                ++ num_copies;
+            }
+        BOOST_LOG_TRIVIAL(debug) << "Filling layers - " << num_copies << " of " << fill_sources.size() << " layer regions repeat the infill of a layer below";
+
         BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - start";
+        // Fill objects are kept per thread for the whole infill step to retain their precomputed pattern data.
+        tbb::enumerable_thread_specific<FillPool> fill_pools;
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, m_layers.size()),
-            [this](const tbb::blocked_range<size_t>& range) {
+            [this, num_regions, &fill_sources, &fill_pools](const tbb::blocked_range<size_t>& range) {
+                FillPool &fill_pool = fill_pools.local();
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                     m_print->throw_if_canceled();
-                    m_layers[layer_idx]->make_fills();
+                    // After a change of a region limited to the infill, only the layers containing the region are filled again.
+                    if (this->infill_dirty(*m_layers[layer_idx]))
+                        for (size_t region_id = 0; region_id < num_regions; ++ region_id)
+                            if (fill_sources[layer_idx * num_regions + region_id] == layer_idx) {
+                                LayerRegion *layerm = m_layers[layer_idx]->regions()[region_id];
+                                layerm->fills.clear();
+                                make_fill(*layerm, layerm->fills, &fill_pool);
+                            }
                 }
             }
         );
         m_print->throw_if_canceled();
         BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - end";
+        if (num_copies > 0) {
+            BOOST_LOG_TRIVIAL(debug) << "Filling layers - copying the repeating infill in parallel - start";
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, m_layers.size()),
+                [this, num_regions, &fill_sources](const tbb::blocked_range<size_t>& range) {
+                    for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                        m_print->throw_if_canceled();
+                        if (this->infill_dirty(*m_layers[layer_idx]))
+                            for (size_t region_id = 0; region_id < num_regions; ++ region_id) {
+                                size_t source = fill_sources[layer_idx * num_regions + region_id];
+                                if (source != layer_idx) {
+                                    LayerRegion *layerm = m_layers[layer_idx]->regions()[region_id];
+                                    layerm->fills.clear();
+                                    copy_fill(*m_layers[source]->regions()[region_id], *layerm, layerm->fills);
+                                }
+                            }
+                    }
+                }
+            );
+            m_print->throw_if_canceled();
+            BOOST_LOG_TRIVIAL(debug) << "Filling layers - copying the repeating infill in parallel - end";
+        }
         /*  we could free memory now, but this would make this step not idempotent
         ### $_->fill_surfaces->clear for map @{$_->regions}, @{$object->layers};
         */
+        this->set_step_counter(posInfill, "extrusions", count_region_extrusions(m_layers, &LayerRegion::fills));
         this->set_done(posInfill);
     }
 }
 
+// Low memory mode: After all the steps of the object are finished, the G-code export only needs the layer slices,
+// the region slices (for the retraction and the travel planning) and the extrusions.
+void PrintObject::release_intermediate_data()
+{
+    if (m_intermediate_data_released)
+        return;
+    for (Layer *layer : m_layers)
+        for (LayerRegion *layerm : layer->regions()) {
+            layerm->fill_surfaces.clear();
+            layerm->fill_surfaces.surfaces.shrink_to_fit();
+            layerm->fill_expolygons.clear();
+            layerm->fill_expolygons.shrink_to_fit();
+            layerm->perimeter_surfaces.clear();
+            layerm->perimeter_surfaces.surfaces.shrink_to_fit();
+            layerm->bridged.clear();
+            layerm->bridged.shrink_to_fit();
+            layerm->unsupported_bridge_edges.polylines.clear();
+        }
+    m_intermediate_data_released = true;
+    BOOST_LOG_TRIVIAL(info) << "Released the intermediate data of an object" << log_memory_info();
+}
+
+void PrintObject::release_extrusions(const Layer *layer, const SupportLayer *support_layer)
+{
+    if (layer != nullptr)
+        for (LayerRegion *layerm : layer->regions()) {
+            layerm->perimeters.clear();
+            layerm->thin_fills.clear();
+            layerm->fills.clear();
+        }
+    if (support_layer != nullptr) {
+        auto it = std::lower_bound(m_support_layers.begin(), m_support_layers.end(), support_layer->print_z - EPSILON, 
+            [](const SupportLayer *l, coordf_t print_z) { return l->print_z < print_z; });
+        for (; it != m_support_layers.end() && (*it)->print_z < support_layer->print_z + EPSILON; ++ it)
+            if (*it == support_layer) {
+                (*it)->support_fills.clear();
+                break;
+            }
+    }
+    m_extrusions_released = true;
+}
+
+// The fill surfaces are needed by the infill and the support generator, the extrusions by all the Print steps.
+// Both are recalculated from the perimeters on, the region slices were not released.
+bool PrintObject::invalidate_released_data()
+{
+    bool released_needed = 
+        (m_intermediate_data_released && 
+            ! (this->is_step_done_unguarded(posPrepareInfill) && this->is_step_done_unguarded(posInfill) && this->is_step_done_unguarded(posSupportMaterial))) ||
+        (m_extrusions_released && ! m_print->is_step_done_unguarded(psGCodeExport));
+    if (! released_needed)
+        return false;
+    m_intermediate_data_released = false;
+    m_extrusions_released        = false;
+    bool invalidated = this->invalidate_step(posPerimeters);
+    invalidated |= this->invalidate_step(posSupportMaterial);
+    return invalidated;
+}
+
 void PrintObject::generate_support_material()
 {
     if (this->set_started(posSupportMaterial)) {
         this->clear_support_layers();
         if ((m_config.support_material || m_config.raft_layers > 0) && m_layers.size() > 1) {
-            m_print->set_status(85, "Generating support material");    
+            m_print->set_object_status(85, "Generating support material");    
             this->_generate_support_material();
             m_print->throw_if_canceled();
         } else {
@@ -395,6 +709,11 @@ void PrintObject::generate_support_material()
                     throw std::runtime_error("Levitating objects cannot be printed without supports.");
 #endif
         }
+        size_t num_support_extrusions = 0;
+        for (const SupportLayer *support_layer : m_support_layers)
+            num_support_extrusions += support_layer->support_fills.items_count();
+        this->set_step_counter(posSupportMaterial, "layers", m_support_layers.size());
+        this->set_step_counter(posSupportMaterial, "extrusions", num_support_extrusions);
         this->set_done(posSupportMaterial);
     }
 }
@@ -432,7 +751,7 @@ SupportLayerPtrs::const_iterator PrintObject::insert_support_layer(SupportLayerP
 
 // Called by Print::apply_config().
 // This method only accepts PrintObjectConfig and PrintRegionConfig option keys.
-bool PrintObject::invalidate_state_by_config_options(const std::vector<t_config_option_key> &opt_keys)
+bool PrintObject::invalidate_state_by_config_options(const std::vector<t_config_option_key> &opt_keys, int region_id)
 {
     if (opt_keys.empty())
         return false;
@@ -548,14 +867,70 @@ bool PrintObject::invalidate_state_by_config_options(const std::vector<t_config_
     }
 
     sort_remove_duplicates(steps);
+    if (region_id >= 0 && steps.size() == 1 && steps.front() == posInfill && 
+        (this->is_step_done_unguarded(posInfill) || ! m_infill_dirty_ranges.empty())) {
+        // Only the infill of a single region is affected and the other layers are filled already.
+        // Fill just the layers containing the region, the infill of a layer does not depend on its neighbors.
+        std::vector<std::pair<coordf_t, coordf_t>> ranges = this->region_z_ranges(size_t(region_id));
+        // If the infill step is not done, the layers of the previous dirty ranges may not be filled yet.
+        // The background infill step may be reading m_infill_dirty_ranges, therefore the ranges are copied
+        // and m_infill_dirty_ranges is only written after invalidate_step() stopped the background processing.
+        std::vector<std::pair<coordf_t, coordf_t>> dirty_ranges;
+        if (! this->is_step_done_unguarded(posInfill))
+            dirty_ranges = m_infill_dirty_ranges;
+        // Invalidating the infill step clears m_infill_dirty_ranges.
+        invalidated |= this->invalidate_step(posInfill);
+        if (! m_intermediate_data_released) {
+            append(dirty_ranges, std::move(ranges));
+            m_infill_dirty_ranges = std::move(dirty_ranges);
+        }
+        // Otherwise the fill surfaces were released in the low memory mode and all the layers are to be filled,
+        // invalidate_released_data() will recalculate them.
+        return invalidated;
+    }
     for (PrintObjectStep step : steps)
         invalidated |= this->invalidate_step(step);
     return invalidated;
 }
 
+// Z ranges of the layers, where the region has some slices.
+// The region slices are not modified by the background processing after the posPrepareInfill step, neither they are released
+// in the low memory mode, while the fill surfaces may be just being released by the background processing.
+std::vector<std::pair<coordf_t, coordf_t>> PrintObject::region_z_ranges(size_t region_id) const
+{
+    std::vector<std::pair<coordf_t, coordf_t>> ranges;
+    bool last_contains = false;
+    for (const Layer *layer : m_layers) {
+        bool contains = region_id < layer->region_count() && ! layer->get_region(int(region_id))->slices.empty();
+        if (contains) {
+            if (last_contains)
+                ranges.back().second = layer->print_z;
+            else
+                ranges.emplace_back(layer->print_z, layer->print_z);
+        }
+        last_contains = contains;
+    }
+    return ranges;
+}
+
+// Is the layer to be processed by the next run of the infill step?
+bool PrintObject::infill_dirty(const Layer &layer) const
+{
+    if (m_infill_dirty_ranges.empty())
+        return true;
+    for (const std::pair<coordf_t, coordf_t> &range : m_infill_dirty_ranges)
+        if (layer.print_z > range.first - EPSILON && layer.print_z < range.second + EPSILON)
+            return true;
+    return false;
+}
+
 bool PrintObject::invalidate_step(PrintObjectStep step)
 {
 	bool invalidated = Inherited::invalidate_step(step);
+    if (step == posSlice || step == posPerimeters || step == posPrepareInfill)
+        m_external_surfaces_processed = false;
+    if (step == posSlice || step == posPerimeters || step == posPrepareInfill || step == posInfill)
+        m_infill_dirty_ranges.clear();
     
     // propagate to dependent steps
     if (step == posPerimeters) {
@@ -585,6 +960,10 @@ bool PrintObject::invalidate_step(PrintObjectStep step)
 
 bool PrintObject::invalidate_all_steps()
 {
+    m_external_surfaces_processed = false;
+    m_infill_dirty_ranges.clear();
+    m_intermediate_data_released = false;
+    m_extrusions_released = false;
     return Inherited::invalidate_all_steps() | m_print->invalidate_all_steps();
 }
 
@@ -631,138 +1010,11 @@ void PrintObject::detect_surfaces_type()
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, m_layers.size()),
             [this, idx_region, interface_shells, &surfaces_new](const tbb::blocked_range<size_t>& range) {
-                // If we have raft layers, consider bottom layer as a bridge just like any other bottom surface lying on the void.
-                SurfaceType surface_type_bottom_1st =
-                    (m_config.raft_layers.value > 0 && m_config.support_material_contact_distance.value > 0) ?
-                    stBottomBridge : stBottom;
-                // If we have soluble support material, don't bridge. The overhang will be squished against a soluble layer separating
-                // the support from the print.
-                SurfaceType surface_type_bottom_other =
-                    (m_config.support_material.value && m_config.support_material_contact_distance.value == 0) ?
-                    stBottom : stBottomBridge;
                 for (size_t idx_layer = range.begin(); idx_layer < range.end(); ++ idx_layer) {
                     m_print->throw_if_canceled();
                     // BOOST_LOG_TRIVIAL(trace) << "Detecting solid surfaces for region " << idx_region << " and layer " << layer->print_z;
-                    Layer       *layer  = m_layers[idx_layer];
-                    LayerRegion *layerm = layer->get_region(idx_region);
-                    // comparison happens against the *full* slices (considering all regions)
-                    // unless internal shells are requested
-                    Layer       *upper_layer = (idx_layer + 1 < this->layer_count()) ? m_layers[idx_layer + 1] : nullptr;
-                    Layer       *lower_layer = (idx_layer > 0) ? m_layers[idx_layer - 1] : nullptr;
-                    // collapse very narrow parts (using the safety offset in the diff is not enough)
-                    float        offset = layerm->flow(frExternalPerimeter).scaled_width() / 10.f;
-
-                    Polygons     layerm_slices_surfaces = to_polygons(layerm->slices.surfaces);
-
-                    // find top surfaces (difference between current surfaces
-                    // of current layer and upper one)
-                    Surfaces top;
-                    if (upper_layer) {
-                        Polygons upper_slices = interface_shells ? 
-                            to_polygons(upper_layer->get_region(idx_region)->slices.surfaces) : 
-                            to_polygons(upper_layer->slices);
-                        surfaces_append(top,
-                            //FIXME implement offset2_ex working over ExPolygons, that should be a bit more efficient than calling offset_ex twice.
-                            offset_ex(offset_ex(diff_ex(layerm_slices_surfaces, upper_slices, true), -offset), offset),
-                            stTop);
-                    } else {
-                        // if no upper layer, all surfaces of this one are solid
-                        // we clone surfaces because we're going to clear the slices collection
-                        top = layerm->slices.surfaces;
-                        for (Surface &surface : top)
-                            surface.surface_type = stTop;
-                    }
-                    
-                    // Find bottom surfaces (difference between current surfaces of current layer and lower one).
-                    Surfaces bottom;
-                    if (lower_layer) {
-#if 0
-                        //FIXME Why is this branch failing t\multi.t ?
-                        Polygons lower_slices = interface_shells ? 
-                            to_polygons(lower_layer->get_region(idx_region)->slices.surfaces) : 
-                            to_polygons(lower_layer->slices);
-                        surfaces_append(bottom,
-                            offset2_ex(diff(layerm_slices_surfaces, lower_slices, true), -offset, offset),
-                            surface_type_bottom_other);
-#else
-                        // Any surface lying on the void is a true bottom bridge (an overhang)
-                        surfaces_append(
-                            bottom,
-                            offset2_ex(
-                                diff(layerm_slices_surfaces, to_polygons(lower_layer->slices), true), 
-                                -offset, offset),
-                            surface_type_bottom_other);
-                        // if user requested internal shells, we need to identify surfaces
-                        // lying on other slices not belonging to this region
-                        if (interface_shells) {
-                            // non-bridging bottom surfaces: any part of this layer lying 
-                            // on something else, excluding those lying on our own region
-                            surfaces_append(
-                                bottom,
-                                offset2_ex(
-                                    diff(
-                                        intersection(layerm_slices_surfaces, to_polygons(lower_layer->slices)), // supported
-                                        to_polygons(lower_layer->get_region(idx_region)->slices.surfaces), 
-                                        true), 
-                                    -offset, offset),
-                                stBottom);
-                        }
-#endif
-                    } else {
-                        // if no lower layer, all surfaces of this one are solid
-                        // we clone surfaces because we're going to clear the slices collection
-                        bottom = layerm->slices.surfaces;
-                        for (Surface &surface : bottom)
-                            surface.surface_type = surface_type_bottom_1st;
-                    }
-                    
-                    // now, if the object contained a thin membrane, we could have overlapping bottom
-                    // and top surfaces; let's do an intersection to discover them and consider them
-                    // as bottom surfaces (to allow for bridge detection)
-                    if (! top.empty() && ! bottom.empty()) {
-        //                Polygons overlapping = intersection(to_polygons(top), to_polygons(bottom));
-        //                Slic3r::debugf "  layer %d contains %d membrane(s)\n", $layerm->layer->id, scalar(@$overlapping)
-        //                    if $Slic3r::debug;
-                        Polygons top_polygons = to_polygons(std::move(top));
-                        top.clear();
-                        surfaces_append(top,
-                            diff_ex(top_polygons, to_polygons(bottom), false),
-                            stTop);
-                    }
-
-        #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-                    {
-                        static int iRun = 0;
-                        std::vector<std::pair<Slic3r::ExPolygons, SVG::ExPolygonAttributes>> expolygons_with_attributes;
-                        expolygons_with_attributes.emplace_back(std::make_pair(union_ex(top),                           SVG::ExPolygonAttributes("green")));
-                        expolygons_with_attributes.emplace_back(std::make_pair(union_ex(bottom),                        SVG::ExPolygonAttributes("brown")));
-                        expolygons_with_attributes.emplace_back(std::make_pair(to_expolygons(layerm->slices.surfaces),  SVG::ExPolygonAttributes("black")));
-                        SVG::export_expolygons(debug_out_path("1_detect_surfaces_type_%d_region%d-layer_%f.svg", iRun ++, idx_region, layer->print_z).c_str(), expolygons_with_attributes);
-                    }
-        #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
-                    
-                    // save surfaces to layer
-                    Surfaces &surfaces_out = interface_shells ? surfaces_new[idx_layer] : layerm->slices.surfaces;
-                    surfaces_out.clear();
-
-                    // find internal surfaces (difference between top/bottom surfaces and others)
-                    {
-                        Polygons topbottom = to_polygons(top);
-                        polygons_append(topbottom, to_polygons(bottom));
-                        surfaces_append(surfaces_out,
-                            diff_ex(layerm_slices_surfaces, topbottom, false),
-                            stInternal);
-                    }
-
-                    surfaces_append(surfaces_out, std::move(top));
-                    surfaces_append(surfaces_out, std::move(bottom));
-                    
-        //            Slic3r::debugf "  layer %d has %d bottom, %d top and %d internal surfaces\n",
-        //                $layerm->layer->id, scalar(@bottom), scalar(@top), scalar(@internal) if $Slic3r::debug;
-
-        #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-                    layerm->export_region_slices_to_svg_debug("detect_surfaces_type-final");
-        #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+                    this->detect_surfaces_type(idx_region, idx_layer, interface_shells,
+                        interface_shells ? surfaces_new[idx_layer] : m_layers[idx_layer]->get_region(idx_region)->slices.surfaces);
                 }
             }
         ); // for each layer of a region
@@ -796,6 +1048,141 @@ void PrintObject::detect_surfaces_type()
     this->typed_slices = true;
 }
 
+// Classify the region slices of a single layer and a single region, see detect_surfaces_type().
+// The result is stored into surfaces_out, which may alias the region slices if interface shells are disabled.
+void PrintObject::detect_surfaces_type(size_t idx_region, size_t idx_layer, bool interface_shells, Surfaces &surfaces_out)
+{
+    // If we have raft layers, consider bottom layer as a bridge just like any other bottom surface lying on the void.
+    SurfaceType surface_type_bottom_1st =
+        (m_config.raft_layers.value > 0 && m_config.support_material_contact_distance.value > 0) ?
+        stBottomBridge : stBottom;
+    // If we have soluble support material, don't bridge. The overhang will be squished against a soluble layer separating
+    // the support from the print.
+    SurfaceType surface_type_bottom_other =
+        (m_config.support_material.value && m_config.support_material_contact_distance.value == 0) ?
+        stBottom : stBottomBridge;
+
+    Layer       *layer  = m_layers[idx_layer];
+    LayerRegion *layerm = layer->get_region(idx_region);
+    // comparison happens against the *full* slices (considering all regions)
+    // unless internal shells are requested
+    Layer       *upper_layer = (idx_layer + 1 < this->layer_count()) ? m_layers[idx_layer + 1] : nullptr;
+    Layer       *lower_layer = (idx_layer > 0) ? m_layers[idx_layer - 1] : nullptr;
+    // collapse very narrow parts (using the safety offset in the diff is not enough)
+    float        offset = layerm->flow(frExternalPerimeter).scaled_width() / 10.f;
+
+    Polygons     layerm_slices_surfaces = to_polygons(layerm->slices.surfaces);
+
+    // find top surfaces (difference between current surfaces
+    // of current layer and upper one)
+    Surfaces top;
+    if (upper_layer) {
+        Polygons upper_slices = interface_shells ? 
+            to_polygons(upper_layer->get_region(idx_region)->slices.surfaces) : 
+            to_polygons(upper_layer->slices);
+        surfaces_append(top,
+            //FIXME implement offset2_ex working over ExPolygons, that should be a bit more efficient than calling offset_ex twice.
+            offset_ex(offset_ex(diff_ex(layerm_slices_surfaces, upper_slices, true), -offset), offset),
+            stTop);
+    } else {
+        // if no upper layer, all surfaces of this one are solid
+        // we clone surfaces because we're going to clear the slices collection
+        top = layerm->slices.surfaces;
+        for (Surface &surface : top)
+            surface.surface_type = stTop;
+    }
+    
+    // Find bottom surfaces (difference between current surfaces of current layer and lower one).
+    Surfaces bottom;
+    if (lower_layer) {
+#if 0
+        //FIXME Why is this branch failing t\multi.t ?
+        Polygons lower_slices = interface_shells ? 
+            to_polygons(lower_layer->get_region(idx_region)->slices.surfaces) : 
+            to_polygons(lower_layer->slices);
+        surfaces_append(bottom,
+            offset2_ex(diff(layerm_slices_surfaces, lower_slices, true), -offset, offset),
+            surface_type_bottom_other);
+#else
+        // Any surface lying on the void is a true bottom bridge (an overhang)
+        surfaces_append(
+            bottom,
+            offset2_ex(
+                diff(layerm_slices_surfaces, to_polygons(lower_layer->slices), true), 
+                -offset, offset),
+            surface_type_bottom_other);
+        // if user requested internal shells, we need to identify surfaces
+        // lying on other slices not belonging to this region
+        if (interface_shells) {
+            // non-bridging bottom surfaces: any part of this layer lying 
+            // on something else, excluding those lying on our own region
+            surfaces_append(
+                bottom,
+                offset2_ex(
+                    diff(
+                        intersection(layerm_slices_surfaces, to_polygons(lower_layer->slices)), // supported
+                        to_polygons(lower_layer->get_region(idx_region)->slices.surfaces), 
+                        true), 
+                    -offset, offset),
+                stBottom);
+        }
+#endif
+    } else {
+        // if no lower layer, all surfaces of this one are solid
+        // we clone surfaces because we're going to clear the slices collection
+        bottom = layerm->slices.surfaces;
+        for (Surface &surface : bottom)
+            surface.surface_type = surface_type_bottom_1st;
+    }
+    
+    // now, if the object contained a thin membrane, we could have overlapping bottom
+    // and top surfaces; let's do an intersection to discover them and consider them
+    // as bottom surfaces (to allow for bridge detection)
+    if (! top.empty() && ! bottom.empty()) {
+//        Polygons overlapping = intersection(to_polygons(top), to_polygons(bottom));
+//        Slic3r::debugf "  layer %d contains %d membrane(s)\n", $layerm->layer->id, scalar(@$overlapping)
+//            if $Slic3r::debug;
+        Polygons top_polygons = to_polygons(std::move(top));
+        top.clear();
+        surfaces_append(top,
+            diff_ex(top_polygons, to_polygons(bottom), false),
+            stTop);
+    }
+
+#ifdef SLIC3R_DEBUG_SLICE_PROCESSING
+    {
+        static int iRun = 0;
+        std::vector<std::pair<Slic3r::ExPolygons, SVG::ExPolygonAttributes>> expolygons_with_attributes;
+        expolygons_with_attributes.emplace_back(std::make_pair(union_ex(top),                           SVG::ExPolygonAttributes("green")));
+        expolygons_with_attributes.emplace_back(std::make_pair(union_ex(bottom),                        SVG::ExPolygonAttributes("brown")));
+        expolygons_with_attributes.emplace_back(std::make_pair(to_expolygons(layerm->slices.surfaces),  SVG::ExPolygonAttributes("black")));
+        SVG::export_expolygons(debug_out_path("1_detect_surfaces_type_%d_region%d-layer_%f.svg", iRun ++, idx_region, layer->print_z).c_str(), expolygons_with_attributes);
+    }
+#endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+    
+    // save surfaces to layer
+    surfaces_out.clear();
+
+    // find internal surfaces (difference between top/bottom surfaces and others)
+    {
+        Polygons topbottom = to_polygons(top);
+        polygons_append(topbottom, to_polygons(bottom));
+        surfaces_append(surfaces_out,
+            diff_ex(layerm_slices_surfaces, topbottom, false),
+            stInternal);
+    }
+
+    surfaces_append(surfaces_out, std::move(top));
+    surfaces_append(surfaces_out, std::move(bottom));
+    
+//    Slic3r::debugf "  layer %d has %d bottom, %d top and %d internal surfaces\n",
+//        $layerm->layer->id, scalar(@bottom), scalar(@top), scalar(@internal) if $Slic3r::debug;
+
+#ifdef SLIC3R_DEBUG_SLICE_PROCESSING
+    layerm->export_region_slices_to_svg_debug("detect_surfaces_type-final");
+#endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+}
+
 void PrintObject::process_external_surfaces()
 {
     BOOST_LOG_TRIVIAL(info) << "Processing external surfaces..." << log_memory_info();
@@ -1209,6 +1596,23 @@ void PrintObject::bridge_over_infill()
 {
     BOOST_LOG_TRIVIAL(info) << "Bridge over infill..." << log_memory_info();
 
+    // Snapshot of the stInternal surfaces of all regions, layer by layer. The bridging only replaces the stInternalSolid
+    // surfaces of the bridged layer, therefore the snapshots stay valid and the layers may be bridged in parallel.
+    std::vector<Polygons> internal_surfaces;
+    if (std::any_of(this->print()->regions().begin(), this->print()->regions().end(), 
+            [](const PrintRegion *region) { return region->config().fill_density.value < 100; })) {
+        internal_surfaces.assign(m_layers.size(), Polygons());
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this, &internal_surfaces](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                    m_print->throw_if_canceled();
+                    for (LayerRegion *layerm : m_layers[layer_idx]->m_regions)
+                        layerm->fill_surfaces.filter_by_type(stInternal, &internal_surfaces[layer_idx]);
+                }
+            });
+    }
+
     for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
         const PrintRegion &region = *m_print->regions()[region_id];
         
@@ -1225,110 +1629,106 @@ void PrintObject::bridge_over_infill()
             *this
         );
         
-		for (LayerPtrs::iterator layer_it = m_layers.begin(); layer_it != m_layers.end(); ++ layer_it) {
+        BOOST_LOG_TRIVIAL(debug) << "Bridge over infill for region " << region_id << " in parallel - start";
+        tbb::parallel_for(
             // skip first layer
-			if (layer_it == m_layers.begin())
-                continue;
-            
-            Layer* layer        = *layer_it;
-            LayerRegion* layerm = layer->m_regions[region_id];
+            tbb::blocked_range<size_t>(1, std::max<size_t>(m_layers.size(), 1)),
+            [this, region_id, &bridge_flow, &internal_surfaces](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                    m_print->throw_if_canceled();
+                    Layer* layer        = m_layers[layer_idx];
+                    LayerRegion* layerm = layer->m_regions[region_id];
             
-            // extract the stInternalSolid surfaces that might be transformed into bridges
-            Polygons internal_solid;
-            layerm->fill_surfaces.filter_by_type(stInternalSolid, &internal_solid);
+                    // extract the stInternalSolid surfaces that might be transformed into bridges
+                    Polygons internal_solid;
+                    layerm->fill_surfaces.filter_by_type(stInternalSolid, &internal_solid);
             
-            // check whether the lower area is deep enough for absorbing the extra flow
-            // (for obvious physical reasons but also for preventing the bridge extrudates
-            // from overflowing in 3D preview)
-            ExPolygons to_bridge;
-            {
-                Polygons to_bridge_pp = internal_solid;
+                    // check whether the lower area is deep enough for absorbing the extra flow
+                    // (for obvious physical reasons but also for preventing the bridge extrudates
+                    // from overflowing in 3D preview)
+                    ExPolygons to_bridge;
+                    {
+                        Polygons to_bridge_pp = internal_solid;
                 
-                // iterate through lower layers spanned by bridge_flow
-                double bottom_z = layer->print_z - bridge_flow.height;
-                for (int i = int(layer_it - m_layers.begin()) - 1; i >= 0; --i) {
-                    const Layer* lower_layer = m_layers[i];
-                    
-                    // stop iterating if layer is lower than bottom_z
-                    if (lower_layer->print_z < bottom_z) break;
-                    
-                    // iterate through regions and collect internal surfaces
-                    Polygons lower_internal;
-                    for (LayerRegion *lower_layerm : lower_layer->m_regions)
-                        lower_layerm->fill_surfaces.filter_by_type(stInternal, &lower_internal);
-                    
-                    // intersect such lower internal surfaces with the candidate solid surfaces
-                    to_bridge_pp = intersection(to_bridge_pp, lower_internal);
-                }
+                        // iterate through lower layers spanned by bridge_flow
+                        double bottom_z = layer->print_z - bridge_flow.height;
+                        for (int i = int(layer_idx) - 1; i >= 0; --i) {
+                            // stop iterating if layer is lower than bottom_z
+                            if (m_layers[i]->print_z < bottom_z) break;
+                            // intersect the internal surfaces of all regions of the lower layer with the candidate solid surfaces
+                            to_bridge_pp = intersection(to_bridge_pp, internal_surfaces[i]);
+                        }
                 
-                // there's no point in bridging too thin/short regions
-                //FIXME Vojtech: The offset2 function is not a geometric offset, 
-                // therefore it may create 1) gaps, and 2) sharp corners, which are outside the original contour.
-                // The gaps will be filled by a separate region, which makes the infill less stable and it takes longer.
-                {
-                    float min_width = float(bridge_flow.scaled_width()) * 3.f;
-                    to_bridge_pp = offset2(to_bridge_pp, -min_width, +min_width);
-                }
+                        // there's no point in bridging too thin/short regions
+                        //FIXME Vojtech: The offset2 function is not a geometric offset, 
+                        // therefore it may create 1) gaps, and 2) sharp corners, which are outside the original contour.
+                        // The gaps will be filled by a separate region, which makes the infill less stable and it takes longer.
+                        {
+                            float min_width = float(bridge_flow.scaled_width()) * 3.f;
+                            to_bridge_pp = offset2(to_bridge_pp, -min_width, +min_width);
+                        }
                 
-                if (to_bridge_pp.empty()) continue;
+                        if (to_bridge_pp.empty()) continue;
                 
-                // convert into ExPolygons
-                to_bridge = union_ex(to_bridge_pp);
-            }
+                        // convert into ExPolygons
+                        to_bridge = union_ex(to_bridge_pp);
+                    }
             
-            #ifdef SLIC3R_DEBUG
-            printf("Bridging " PRINTF_ZU " internal areas at layer " PRINTF_ZU "\n", to_bridge.size(), layer->id());
-            #endif
+                    #ifdef SLIC3R_DEBUG
+                    printf("Bridging " PRINTF_ZU " internal areas at layer " PRINTF_ZU "\n", to_bridge.size(), layer->id());
+                    #endif
             
-            // compute the remaning internal solid surfaces as difference
-            ExPolygons not_to_bridge = diff_ex(internal_solid, to_polygons(to_bridge), true);
-            to_bridge = intersection_ex(to_polygons(to_bridge), internal_solid, true);
-            // build the new collection of fill_surfaces
-            layerm->fill_surfaces.remove_type(stInternalSolid);
-            for (ExPolygon &ex : to_bridge)
-                layerm->fill_surfaces.surfaces.push_back(Surface(stInternalBridge, ex));
-            for (ExPolygon &ex : not_to_bridge)
-                layerm->fill_surfaces.surfaces.push_back(Surface(stInternalSolid, ex));            
-            /*
-            # exclude infill from the layers below if needed
-            # see discussion at https://github.com/alexrj/Slic3r/issues/240
-            # Update: do not exclude any infill. Sparse infill is able to absorb the excess material.
-            if (0) {
-                my $excess = $layerm->extruders->{infill}->bridge_flow->width - $layerm->height;
-                for (my $i = $layer_id-1; $excess >= $self->get_layer($i)->height; $i--) {
-                    Slic3r::debugf "  skipping infill below those areas at layer %d\n", $i;
-                    foreach my $lower_layerm (@{$self->get_layer($i)->regions}) {
-                        my @new_surfaces = ();
-                        # subtract the area from all types of surfaces
-                        foreach my $group (@{$lower_layerm->fill_surfaces->group}) {
-                            push @new_surfaces, map $group->[0]->clone(expolygon => $_),
-                                @{diff_ex(
-                                    [ map $_->p, @$group ],
-                                    [ map @$_, @$to_bridge ],
-                                )};
-                            push @new_surfaces, map Slic3r::Surface->new(
-                                expolygon       => $_,
-                                surface_type    => S_TYPE_INTERNALVOID,
-                            ), @{intersection_ex(
-                                [ map $_->p, @$group ],
-                                [ map @$_, @$to_bridge ],
-                            )};
+                    // compute the remaning internal solid surfaces as difference
+                    ExPolygons not_to_bridge = diff_ex(internal_solid, to_polygons(to_bridge), true);
+                    to_bridge = intersection_ex(to_polygons(to_bridge), internal_solid, true);
+                    // build the new collection of fill_surfaces
+                    layerm->fill_surfaces.remove_type(stInternalSolid);
+                    for (ExPolygon &ex : to_bridge)
+                        layerm->fill_surfaces.surfaces.push_back(Surface(stInternalBridge, ex));
+                    for (ExPolygon &ex : not_to_bridge)
+                        layerm->fill_surfaces.surfaces.push_back(Surface(stInternalSolid, ex));            
+                    /*
+                    # exclude infill from the layers below if needed
+                    # see discussion at https://github.com/alexrj/Slic3r/issues/240
+                    # Update: do not exclude any infill. Sparse infill is able to absorb the excess material.
+                    if (0) {
+                        my $excess = $layerm->extruders->{infill}->bridge_flow->width - $layerm->height;
+                        for (my $i = $layer_id-1; $excess >= $self->get_layer($i)->height; $i--) {
+                            Slic3r::debugf "  skipping infill below those areas at layer %d\n", $i;
+                            foreach my $lower_layerm (@{$self->get_layer($i)->regions}) {
+                                my @new_surfaces = ();
+                                # subtract the area from all types of surfaces
+                                foreach my $group (@{$lower_layerm->fill_surfaces->group}) {
+                                    push @new_surfaces, map $group->[0]->clone(expolygon => $_),
+                                        @{diff_ex(
+                                            [ map $_->p, @$group ],
+                                            [ map @$_, @$to_bridge ],
+                                        )};
+                                    push @new_surfaces, map Slic3r::Surface->new(
+                                        expolygon       => $_,
+                                        surface_type    => S_TYPE_INTERNALVOID,
+                                    ), @{intersection_ex(
+                                        [ map $_->p, @$group ],
+                                        [ map @$_, @$to_bridge ],
+                                    )};
+                                }
+                                $lower_layerm->fill_surfaces->clear;
+                                $lower_layerm->fill_surfaces->append($_) for @new_surfaces;
+                            }
+                    
+                            $excess -= $self->get_layer($i)->height;
                         }
-                        $lower_layerm->fill_surfaces->clear;
-                        $lower_layerm->fill_surfaces->append($_) for @new_surfaces;
                     }
-                    
-                    $excess -= $self->get_layer($i)->height;
-                }
-            }
-            */
+                    */
 
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-            layerm->export_region_slices_to_svg_debug("7_bridge_over_infill");
-            layerm->export_region_fill_surfaces_to_svg_debug("7_bridge_over_infill");
+                    layerm->export_region_slices_to_svg_debug("7_bridge_over_infill");
+                    layerm->export_region_fill_surfaces_to_svg_debug("7_bridge_over_infill");
 #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
-            m_print->throw_if_canceled();
-        }
+                }
+            });
+        m_print->throw_if_canceled();
+        BOOST_LOG_TRIVIAL(debug) << "Bridge over infill for region " << region_id << " in parallel - end";
     }
 }
 
@@ -1802,12 +2202,7 @@ std::vector<ExPolygons> PrintObject::_slice_volumes(const std::vector<float> &z,
             // apply XY shift
             mesh.translate(- unscale<float>(m_copies_shift(0)), - unscale<float>(m_copies_shift(1)), 0);
             // perform actual slicing
-            TriangleMeshSlicer mslicer;
-            const Print *print = this->print();
-            auto callback = TriangleMeshSlicer::throw_on_cancel_callback_type([print](){print->throw_if_canceled();});
-            mslicer.init(&mesh, callback);
-			mslicer.slice(z, float(m_config.slice_closing_radius.value), &layers, callback);
-            m_print->throw_if_canceled();
+            this->_slice_mesh(mesh, z, layers);
         }
     }
     return layers;
@@ -1825,16 +2220,37 @@ std::vector<ExPolygons> PrintObject::_slice_volume(const std::vector<float> &z,
         // apply XY shift
         mesh.translate(- unscale<float>(m_copies_shift(0)), - unscale<float>(m_copies_shift(1)), 0);
         // perform actual slicing
-        TriangleMeshSlicer mslicer;
-        const Print *print = this->print();
-        auto callback = TriangleMeshSlicer::throw_on_cancel_callback_type([print](){print->throw_if_canceled();});
-        mslicer.init(&mesh, callback);
-        mslicer.slice(z, float(m_config.slice_closing_radius.value), &layers, callback);
-        m_print->throw_if_canceled();
+        this->_slice_mesh(mesh, z, layers);
     }
     return layers;
 }
 
+// Slice a mesh transformed to the print coordinate system.
+// If the slice cache is enabled, the slices are loaded from the cache if the same mesh has already been sliced
+// at the same Z levels, otherwise the slices are calculated and stored into the cache.
+void PrintObject::_slice_mesh(TriangleMesh &mesh, const std::vector<float> &z, std::vector<ExPolygons> &layers) const
+{
+    SliceCache  cache(m_print->config().slice_cache.value, size_t(m_print->config().slice_cache_size.value) << 20);
+    float       closing_radius = float(m_config.slice_closing_radius.value);
+    std::string key;
+    if (cache.enabled()) {
+        key = SliceCache::hash(mesh, z, closing_radius);
+        if (cache.load(key, z.size(), layers)) {
+            BOOST_LOG_TRIVIAL(debug) << "Slicing objects - slices loaded from the slice cache";
+            m_print->throw_if_canceled();
+            return;
+        }
+    }
+    TriangleMeshSlicer mslicer;
+    const Print *print = this->print();
+    auto callback = TriangleMeshSlicer::throw_on_cancel_callback_type([print](){print->throw_if_canceled();});
+    mslicer.init(&mesh, callback);
+    mslicer.slice(z, closing_radius, &layers, callback);
+    m_print->throw_if_canceled();
+    if (cache.enabled())
+        cache.store(key, layers);
+}
+
 std::string PrintObject::_fix_slicing_errors()
 {
     // Collect layers with slicing errors.
@@ -2059,72 +2475,115 @@ void PrintObject::clip_fill_surfaces()
     // We only want infill under ceilings; this is almost like an
     // internal support material.
     // Proceed top-down, skipping the bottom layer.
-    Polygons upper_internal;
-    for (int layer_id = int(m_layers.size()) - 1; layer_id > 0; -- layer_id) {
-        Layer *layer       = m_layers[layer_id];
-        Layer *lower_layer = m_layers[layer_id - 1];
-        // Detect things that we need to support.
-        // Cummulative slices.
-        Polygons slices;
-        for (const ExPolygon &expoly : layer->slices.expolygons)
-            polygons_append(slices, to_polygons(expoly));
-        // Cummulative fill surfaces.
-        Polygons fill_surfaces;
-        // Solid surfaces to be supported.
-        Polygons overhangs;
-        for (const LayerRegion *layerm : layer->m_regions)
-            for (const Surface &surface : layerm->fill_surfaces.surfaces) {
-                Polygons polygons = to_polygons(surface.expolygon);
-                if (surface.is_solid())
-                    polygons_append(overhangs, polygons);
-                polygons_append(fill_surfaces, std::move(polygons));
-            }
-        Polygons lower_layer_fill_surfaces;
-        Polygons lower_layer_internal_surfaces;
-        for (const LayerRegion *layerm : lower_layer->m_regions)
-            for (const Surface &surface : layerm->fill_surfaces.surfaces) {
-                Polygons polygons = to_polygons(surface.expolygon);
-                if (surface.surface_type == stInternal || surface.surface_type == stInternalVoid)
-                    polygons_append(lower_layer_internal_surfaces, polygons);
-                polygons_append(lower_layer_fill_surfaces, std::move(polygons));
+    // The areas to be supported at each layer are calculated in parallel from the state before clipping, as clipping only
+    // splits the stInternal / stInternalVoid surfaces of the lower layer, so the area covered by the fill surfaces does not change.
+    // Only the propagation of the internal infill from the top down is sequential.
+    std::vector<Polygons> overhangs(m_layers.size());
+    std::vector<Polygons> internal_surfaces(m_layers.size());
+    BOOST_LOG_TRIVIAL(debug) << "Clipping the fill surfaces in parallel - start";
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, m_layers.size()),
+        [this, &overhangs, &internal_surfaces](const tbb::blocked_range<size_t>& range) {
+            for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
+                m_print->throw_if_canceled();
+                const Layer *layer = m_layers[layer_id];
+                for (const LayerRegion *layerm : layer->m_regions)
+                    for (const Surface &surface : layerm->fill_surfaces.surfaces)
+                        if (surface.surface_type == stInternal || surface.surface_type == stInternalVoid)
+                            polygons_append(internal_surfaces[layer_id], to_polygons(surface.expolygon));
+                if (layer_id == 0)
+                    continue;
+                const Layer *lower_layer = m_layers[layer_id - 1];
+                // Detect things that we need to support.
+                // Cummulative slices.
+                Polygons slices;
+                for (const ExPolygon &expoly : layer->slices.expolygons)
+                    polygons_append(slices, to_polygons(expoly));
+                // Cummulative fill surfaces.
+                Polygons fill_surfaces;
+                // Solid surfaces to be supported.
+                Polygons &layer_overhangs = overhangs[layer_id];
+                for (const LayerRegion *layerm : layer->m_regions)
+                    for (const Surface &surface : layerm->fill_surfaces.surfaces) {
+                        Polygons polygons = to_polygons(surface.expolygon);
+                        if (surface.is_solid())
+                            polygons_append(layer_overhangs, polygons);
+                        polygons_append(fill_surfaces, std::move(polygons));
+                    }
+                Polygons lower_layer_fill_surfaces;
+                for (const LayerRegion *layerm : lower_layer->m_regions)
+                    for (const Surface &surface : layerm->fill_surfaces.surfaces)
+                        polygons_append(lower_layer_fill_surfaces, to_polygons(surface.expolygon));
+                // We also need to support perimeters when there's at least one full unsupported loop
+                {
+                    // Get perimeters area as the difference between slices and fill_surfaces
+                    // Only consider the area that is not supported by lower perimeters
+                    Polygons perimeters = intersection(diff(slices, fill_surfaces), lower_layer_fill_surfaces);
+                    // Only consider perimeter areas that are at least one extrusion width thick.
+                    //FIXME Offset2 eats out from both sides, while the perimeters are create outside in.
+                    //Should the pw not be half of the current value?
+                    float pw = FLT_MAX;
+                    for (const LayerRegion *layerm : layer->m_regions)
+                        pw = std::min<float>(pw, layerm->flow(frPerimeter).scaled_width());
+                    // Append such thick perimeters to the areas that need support
+                    polygons_append(layer_overhangs, offset2(perimeters, -pw, +pw));
+                }
             }
-        // We also need to support perimeters when there's at least one full unsupported loop
-        {
-            // Get perimeters area as the difference between slices and fill_surfaces
-            // Only consider the area that is not supported by lower perimeters
-            Polygons perimeters = intersection(diff(slices, fill_surfaces), lower_layer_fill_surfaces);
-            // Only consider perimeter areas that are at least one extrusion width thick.
-            //FIXME Offset2 eats out from both sides, while the perimeters are create outside in.
-            //Should the pw not be half of the current value?
-            float pw = FLT_MAX;
-            for (const LayerRegion *layerm : layer->m_regions)
-                pw = std::min<float>(pw, layerm->flow(frPerimeter).scaled_width());
-            // Append such thick perimeters to the areas that need support
-            polygons_append(overhangs, offset2(perimeters, -pw, +pw));
-        }
-        // Find new internal infill.
-        polygons_append(overhangs, std::move(upper_internal));
-        upper_internal = intersection(overhangs, lower_layer_internal_surfaces);
-        // Apply new internal infill to regions.
-        for (LayerRegion *layerm : lower_layer->m_regions) {
-            if (layerm->region()->config().fill_density.value == 0)
-                continue;
-            SurfaceType internal_surface_types[] = { stInternal, stInternalVoid };
-            Polygons internal;
-            for (Surface &surface : layerm->fill_surfaces.surfaces)
-                if (surface.surface_type == stInternal || surface.surface_type == stInternalVoid)
-                    polygons_append(internal, std::move(surface.expolygon));
-            layerm->fill_surfaces.remove_types(internal_surface_types, 2);
-            layerm->fill_surfaces.append(intersection_ex(internal, upper_internal, true), stInternal);
-            layerm->fill_surfaces.append(diff_ex        (internal, upper_internal, true), stInternalVoid);
-            // If there are voids it means that our internal infill is not adjacent to
-            // perimeters. In this case it would be nice to add a loop around infill to
-            // make it more robust and nicer. TODO.
+        });
+    m_print->throw_if_canceled();
+
+    // Find new internal infill, top down.
+    std::vector<Polygons> upper_internal(m_layers.size());
+    for (int layer_id = int(m_layers.size()) - 1; layer_id > 0; -- layer_id) {
+        // The internal infill of this layer has to be supported as well.
+        polygons_append(overhangs[layer_id], upper_internal[layer_id]);
+        upper_internal[layer_id - 1] = intersection(overhangs[layer_id], internal_surfaces[layer_id - 1]);
+        overhangs[layer_id].clear();
+        m_print->throw_if_canceled();
+    }
+    overhangs.clear();
+    internal_surfaces.clear();
+
+    // Apply new internal infill to regions.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, std::max<size_t>(m_layers.size(), 1) - 1),
+        [this, &upper_internal](const tbb::blocked_range<size_t>& range) {
+            for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
+                m_print->throw_if_canceled();
+                for (LayerRegion *layerm : m_layers[layer_id]->m_regions) {
+                    if (layerm->region()->config().fill_density.value == 0)
+                        continue;
+                    SurfaceType internal_surface_types[] = { stInternal, stInternalVoid };
+                    Polygons internal;
+                    for (Surface &surface : layerm->fill_surfaces.surfaces)
+                        if (surface.surface_type == stInternal || surface.surface_type == stInternalVoid)
+                            polygons_append(internal, std::move(surface.expolygon));
+                    layerm->fill_surfaces.remove_types(internal_surface_types, 2);
+                    layerm->fill_surfaces.append(intersection_ex(internal, upper_internal[layer_id], true), stInternal);
+                    layerm->fill_surfaces.append(diff_ex        (internal, upper_internal[layer_id], true), stInternalVoid);
+                    // If there are voids it means that our internal infill is not adjacent to
+                    // perimeters. In this case it would be nice to add a loop around infill to
+                    // make it more robust and nicer. TODO.
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-            layerm->export_region_fill_surfaces_to_svg_debug("6_clip_fill_surfaces");
+                    layerm->export_region_fill_surfaces_to_svg_debug("6_clip_fill_surfaces");
 #endif
-        }
-        m_print->throw_if_canceled();
+                }
+            }
+        });
+    m_print->throw_if_canceled();
+    BOOST_LOG_TRIVIAL(debug) << "Clipping the fill surfaces in parallel - end";
+}
+
+// Insert a solid internal layer every solid_infill_every_layers. Mark stInternal surfaces as stInternalSolid or stInternalBridge.
+static void mark_solid_infill_layer(LayerRegion &layerm, int layer_idx)
+{
+    const PrintRegionConfig &region_config = layerm.region()->config();
+    if (region_config.solid_infill_every_layers.value > 0 && region_config.fill_density.value > 0 &&
+        (layer_idx % region_config.solid_infill_every_layers) == 0) {
+        SurfaceType type = (region_config.fill_density == 100) ? stInternalSolid : stInternalBridge;
+        for (Surface &surface : layerm.fill_surfaces.surfaces)
+            if (surface.surface_type == stInternal)
+                surface.surface_type = type;
     }
 }
 
@@ -2132,188 +2591,206 @@ void PrintObject::discover_horizontal_shells()
 {
     BOOST_LOG_TRIVIAL(trace) << "discover_horizontal_shells()";
     
+    // The regions only modify their own LayerRegions, therefore they are processed in parallel.
+    BOOST_LOG_TRIVIAL(debug) << "Discovering horizontal shells in parallel - start";
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, this->region_volumes.size()),
+        [this](const tbb::blocked_range<size_t>& range) {
+            for (size_t region_id = range.begin(); region_id < range.end(); ++ region_id)
+                this->discover_horizontal_shells(region_id);
+        });
+    m_print->throw_if_canceled();
+    BOOST_LOG_TRIVIAL(debug) << "Discovering horizontal shells in parallel - end";
+
+#ifdef SLIC3R_DEBUG_SLICE_PROCESSING
     for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
-        for (int i = 0; i < int(m_layers.size()); ++ i) {
-            m_print->throw_if_canceled();
-            LayerRegion             *layerm = m_layers[i]->regions()[region_id];
-            const PrintRegionConfig &region_config = layerm->region()->config();
-            if (region_config.solid_infill_every_layers.value > 0 && region_config.fill_density.value > 0 &&
-                (i % region_config.solid_infill_every_layers) == 0) {
-                // Insert a solid internal layer. Mark stInternal surfaces as stInternalSolid or stInternalBridge.
-                SurfaceType type = (region_config.fill_density == 100) ? stInternalSolid : stInternalBridge;
-                for (Surface &surface : layerm->fill_surfaces.surfaces)
-                    if (surface.surface_type == stInternal)
-                        surface.surface_type = type;
-            }
+        for (const Layer *layer : m_layers) {
+            const LayerRegion *layerm = layer->m_regions[region_id];
+            layerm->export_region_slices_to_svg_debug("5_discover_horizontal_shells");
+            layerm->export_region_fill_surfaces_to_svg_debug("5_discover_horizontal_shells");
+        } // for each layer
+    } // for each region
+#endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+}
+
+void PrintObject::discover_horizontal_shells(size_t region_id)
+{
+    const PrintRegionConfig &region_config = m_print->get_region(region_id)->config();
 
-            // If ensure_vertical_shell_thickness, then the rest has already been performed by discover_vertical_shells().
-            if (region_config.ensure_vertical_shell_thickness.value)
+    // If ensure_vertical_shell_thickness, then the rest has already been performed by discover_vertical_shells(),
+    // and the solid infill layers are marked independently of each other.
+    if (region_config.ensure_vertical_shell_thickness.value) {
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this, region_id](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++ i) {
+                    m_print->throw_if_canceled();
+                    mark_solid_infill_layer(*m_layers[i]->regions()[region_id], int(i));
+                }
+            });
+        return;
+    }
+
+    // Otherwise the layers are processed in sequence: Propagating the shells from a layer modifies the fill_surfaces
+    // of its neighbor layers, which are in turn the input of the propagation from the following layers.
+    for (int i = 0; i < int(m_layers.size()); ++ i) {
+        m_print->throw_if_canceled();
+        LayerRegion *layerm = m_layers[i]->regions()[region_id];
+        mark_solid_infill_layer(*layerm, i);
+
+        for (int idx_surface_type = 0; idx_surface_type < 3; ++ idx_surface_type) {
+            m_print->throw_if_canceled();
+            SurfaceType type = (idx_surface_type == 0) ? stTop : (idx_surface_type == 1) ? stBottom : stBottomBridge;
+            // Find slices of current type for current layer.
+            // Use slices instead of fill_surfaces, because they also include the perimeter area,
+            // which needs to be propagated in shells; we need to grow slices like we did for
+            // fill_surfaces though. Using both ungrown slices and grown fill_surfaces will
+            // not work in some situations, as there won't be any grown region in the perimeter 
+            // area (this was seen in a model where the top layer had one extra perimeter, thus
+            // its fill_surfaces were thinner than the lower layer's infill), however it's the best
+            // solution so far. Growing the external slices by EXTERNAL_INFILL_MARGIN will put
+            // too much solid infill inside nearly-vertical slopes.
+
+            // Surfaces including the area of perimeters. Everything, that is visible from the top / bottom
+            // (not covered by a layer above / below).
+            // This does not contain the areas covered by perimeters!
+            Polygons solid;
+            for (const Surface &surface : layerm->slices.surfaces)
+                if (surface.surface_type == type)
+                    polygons_append(solid, to_polygons(surface.expolygon));
+            // Infill areas (slices without the perimeters).
+            for (const Surface &surface : layerm->fill_surfaces.surfaces)
+                if (surface.surface_type == type)
+                    polygons_append(solid, to_polygons(surface.expolygon));
+            if (solid.empty())
                 continue;
+//                Slic3r::debugf "Layer %d has %s surfaces\n", $i, ($type == S_TYPE_TOP) ? 'top' : 'bottom';
             
-            for (int idx_surface_type = 0; idx_surface_type < 3; ++ idx_surface_type) {
-                m_print->throw_if_canceled();
-                SurfaceType type = (idx_surface_type == 0) ? stTop : (idx_surface_type == 1) ? stBottom : stBottomBridge;
-                // Find slices of current type for current layer.
-                // Use slices instead of fill_surfaces, because they also include the perimeter area,
-                // which needs to be propagated in shells; we need to grow slices like we did for
-                // fill_surfaces though. Using both ungrown slices and grown fill_surfaces will
-                // not work in some situations, as there won't be any grown region in the perimeter 
-                // area (this was seen in a model where the top layer had one extra perimeter, thus
-                // its fill_surfaces were thinner than the lower layer's infill), however it's the best
-                // solution so far. Growing the external slices by EXTERNAL_INFILL_MARGIN will put
-                // too much solid infill inside nearly-vertical slopes.
-
-                // Surfaces including the area of perimeters. Everything, that is visible from the top / bottom
-                // (not covered by a layer above / below).
-                // This does not contain the areas covered by perimeters!
-                Polygons solid;
-                for (const Surface &surface : layerm->slices.surfaces)
-                    if (surface.surface_type == type)
-                        polygons_append(solid, to_polygons(surface.expolygon));
-                // Infill areas (slices without the perimeters).
-                for (const Surface &surface : layerm->fill_surfaces.surfaces)
-                    if (surface.surface_type == type)
-                        polygons_append(solid, to_polygons(surface.expolygon));
-                if (solid.empty())
+            size_t solid_layers = (type == stTop) ? region_config.top_solid_layers.value : region_config.bottom_solid_layers.value;                
+            for (int n = (type == stTop) ? i-1 : i+1; std::abs(n - i) < solid_layers; (type == stTop) ? -- n : ++ n) {
+                if (n < 0 || n >= int(m_layers.size()))
                     continue;
-//                Slic3r::debugf "Layer %d has %s surfaces\n", $i, ($type == S_TYPE_TOP) ? 'top' : 'bottom';
+//                    Slic3r::debugf "  looking for neighbors on layer %d...\n", $n;                  
+                // Reference to the lower layer of a TOP surface, or an upper layer of a BOTTOM surface.
+                LayerRegion *neighbor_layerm = m_layers[n]->regions()[region_id];
                 
-                size_t solid_layers = (type == stTop) ? region_config.top_solid_layers.value : region_config.bottom_solid_layers.value;                
-                for (int n = (type == stTop) ? i-1 : i+1; std::abs(n - i) < solid_layers; (type == stTop) ? -- n : ++ n) {
-                    if (n < 0 || n >= int(m_layers.size()))
+                // find intersection between neighbor and current layer's surfaces
+                // intersections have contours and holes
+                // we update $solid so that we limit the next neighbor layer to the areas that were
+                // found on this one - in other words, solid shells on one layer (for a given external surface)
+                // are always a subset of the shells found on the previous shell layer
+                // this approach allows for DWIM in hollow sloping vases, where we want bottom
+                // shells to be generated in the base but not in the walls (where there are many
+                // narrow bottom surfaces): reassigning $solid will consider the 'shadow' of the 
+                // upper perimeter as an obstacle and shell will not be propagated to more upper layers
+                //FIXME How does it work for S_TYPE_INTERNALBRIDGE? This is set for sparse infill. Likely this does not work.
+                Polygons new_internal_solid;
+                {
+                    Polygons internal;
+                    for (const Surface &surface : neighbor_layerm->fill_surfaces.surfaces)
+                        if (surface.surface_type == stInternal || surface.surface_type == stInternalSolid)
+                            polygons_append(internal, to_polygons(surface.expolygon));
+                    new_internal_solid = intersection(solid, internal, true);
+                }
+                if (new_internal_solid.empty()) {
+                    // No internal solid needed on this layer. In order to decide whether to continue
+                    // searching on the next neighbor (thus enforcing the configured number of solid
+                    // layers, use different strategies according to configured infill density:
+                    if (region_config.fill_density.value == 0) {
+                        // If user expects the object to be void (for example a hollow sloping vase),
+                        // don't continue the search. In this case, we only generate the external solid
+                        // shell if the object would otherwise show a hole (gap between perimeters of 
+                        // the two layers), and internal solid shells are a subset of the shells found 
+                        // on each previous layer.
+                        goto EXTERNAL;
+                    } else {
+                        // If we have internal infill, we can generate internal solid shells freely.
                         continue;
-//                    Slic3r::debugf "  looking for neighbors on layer %d...\n", $n;                  
-                    // Reference to the lower layer of a TOP surface, or an upper layer of a BOTTOM surface.
-                    LayerRegion *neighbor_layerm = m_layers[n]->regions()[region_id];
-                    
-                    // find intersection between neighbor and current layer's surfaces
-                    // intersections have contours and holes
-                    // we update $solid so that we limit the next neighbor layer to the areas that were
-                    // found on this one - in other words, solid shells on one layer (for a given external surface)
-                    // are always a subset of the shells found on the previous shell layer
-                    // this approach allows for DWIM in hollow sloping vases, where we want bottom
-                    // shells to be generated in the base but not in the walls (where there are many
-                    // narrow bottom surfaces): reassigning $solid will consider the 'shadow' of the 
-                    // upper perimeter as an obstacle and shell will not be propagated to more upper layers
-                    //FIXME How does it work for S_TYPE_INTERNALBRIDGE? This is set for sparse infill. Likely this does not work.
-                    Polygons new_internal_solid;
-                    {
+                    }
+                }
+                
+                if (region_config.fill_density.value == 0) {
+                    // if we're printing a hollow object we discard any solid shell thinner
+                    // than a perimeter width, since it's probably just crossing a sloping wall
+                    // and it's not wanted in a hollow print even if it would make sense when
+                    // obeying the solid shell count option strictly (DWIM!)
+                    float margin = float(neighbor_layerm->flow(frExternalPerimeter).scaled_width());
+                    Polygons too_narrow = diff(
+                        new_internal_solid, 
+                        offset2(new_internal_solid, -margin, +margin, jtMiter, 5), 
+                        true);
+                    // Trim the regularized region by the original region.
+                    if (! too_narrow.empty())
+                        new_internal_solid = solid = diff(new_internal_solid, too_narrow);
+                }
+
+                // make sure the new internal solid is wide enough, as it might get collapsed
+                // when spacing is added in Fill.pm
+                {
+                    //FIXME Vojtech: Disable this and you will be sorry.
+                    // https://github.com/prusa3d/Slic3r/issues/26 bottom
+                    float margin = 3.f * layerm->flow(frSolidInfill).scaled_width(); // require at least this size
+                    // we use a higher miterLimit here to handle areas with acute angles
+                    // in those cases, the default miterLimit would cut the corner and we'd
+                    // get a triangle in $too_narrow; if we grow it below then the shell
+                    // would have a different shape from the external surface and we'd still
+                    // have the same angle, so the next shell would be grown even more and so on.
+                    Polygons too_narrow = diff(
+                        new_internal_solid,
+                        offset2(new_internal_solid, -margin, +margin, ClipperLib::jtMiter, 5),
+                        true);
+                    if (! too_narrow.empty()) {
+                        // grow the collapsing parts and add the extra area to  the neighbor layer 
+                        // as well as to our original surfaces so that we support this 
+                        // additional area in the next shell too
+                        // make sure our grown surfaces don't exceed the fill area
                         Polygons internal;
                         for (const Surface &surface : neighbor_layerm->fill_surfaces.surfaces)
-                            if (surface.surface_type == stInternal || surface.surface_type == stInternalSolid)
+                            if (surface.is_internal() && !surface.is_bridge())
                                 polygons_append(internal, to_polygons(surface.expolygon));
-                        new_internal_solid = intersection(solid, internal, true);
+                        polygons_append(new_internal_solid, 
+                            intersection(
+                                offset(too_narrow, +margin),
+                                // Discard bridges as they are grown for anchoring and we can't
+                                // remove such anchors. (This may happen when a bridge is being 
+                                // anchored onto a wall where little space remains after the bridge
+                                // is grown, and that little space is an internal solid shell so 
+                                // it triggers this too_narrow logic.)
+                                internal));
+                        solid = new_internal_solid;
                     }
-                    if (new_internal_solid.empty()) {
-                        // No internal solid needed on this layer. In order to decide whether to continue
-                        // searching on the next neighbor (thus enforcing the configured number of solid
-                        // layers, use different strategies according to configured infill density:
-                        if (region_config.fill_density.value == 0) {
-                            // If user expects the object to be void (for example a hollow sloping vase),
-                            // don't continue the search. In this case, we only generate the external solid
-                            // shell if the object would otherwise show a hole (gap between perimeters of 
-                            // the two layers), and internal solid shells are a subset of the shells found 
-                            // on each previous layer.
-                            goto EXTERNAL;
-                        } else {
-                            // If we have internal infill, we can generate internal solid shells freely.
-                            continue;
-                        }
-                    }
-                    
-                    if (region_config.fill_density.value == 0) {
-                        // if we're printing a hollow object we discard any solid shell thinner
-                        // than a perimeter width, since it's probably just crossing a sloping wall
-                        // and it's not wanted in a hollow print even if it would make sense when
-                        // obeying the solid shell count option strictly (DWIM!)
-                        float margin = float(neighbor_layerm->flow(frExternalPerimeter).scaled_width());
-                        Polygons too_narrow = diff(
-                            new_internal_solid, 
-                            offset2(new_internal_solid, -margin, +margin, jtMiter, 5), 
-                            true);
-                        // Trim the regularized region by the original region.
-                        if (! too_narrow.empty())
-                            new_internal_solid = solid = diff(new_internal_solid, too_narrow);
-                    }
-
-                    // make sure the new internal solid is wide enough, as it might get collapsed
-                    // when spacing is added in Fill.pm
-                    {
-                        //FIXME Vojtech: Disable this and you will be sorry.
-                        // https://github.com/prusa3d/Slic3r/issues/26 bottom
-                        float margin = 3.f * layerm->flow(frSolidInfill).scaled_width(); // require at least this size
-                        // we use a higher miterLimit here to handle areas with acute angles
-                        // in those cases, the default miterLimit would cut the corner and we'd
-                        // get a triangle in $too_narrow; if we grow it below then the shell
-                        // would have a different shape from the external surface and we'd still
-                        // have the same angle, so the next shell would be grown even more and so on.
-                        Polygons too_narrow = diff(
-                            new_internal_solid,
-                            offset2(new_internal_solid, -margin, +margin, ClipperLib::jtMiter, 5),
-                            true);
-                        if (! too_narrow.empty()) {
-                            // grow the collapsing parts and add the extra area to  the neighbor layer 
-                            // as well as to our original surfaces so that we support this 
-                            // additional area in the next shell too
-                            // make sure our grown surfaces don't exceed the fill area
-                            Polygons internal;
-                            for (const Surface &surface : neighbor_layerm->fill_surfaces.surfaces)
-                                if (surface.is_internal() && !surface.is_bridge())
-                                    polygons_append(internal, to_polygons(surface.expolygon));
-                            polygons_append(new_internal_solid, 
-                                intersection(
-                                    offset(too_narrow, +margin),
-                                    // Discard bridges as they are grown for anchoring and we can't
-                                    // remove such anchors. (This may happen when a bridge is being 
-                                    // anchored onto a wall where little space remains after the bridge
-                                    // is grown, and that little space is an internal solid shell so 
-                                    // it triggers this too_narrow logic.)
-                                    internal));
-                            solid = new_internal_solid;
-                        }
-                    }
-                    
-                    // internal-solid are the union of the existing internal-solid surfaces
-                    // and new ones
-                    SurfaceCollection backup = std::move(neighbor_layerm->fill_surfaces);
-                    polygons_append(new_internal_solid, to_polygons(backup.filter_by_type(stInternalSolid)));
-                    ExPolygons internal_solid = union_ex(new_internal_solid, false);
-                    // assign new internal-solid surfaces to layer
-                    neighbor_layerm->fill_surfaces.set(internal_solid, stInternalSolid);
-                    // subtract intersections from layer surfaces to get resulting internal surfaces
-                    Polygons polygons_internal = to_polygons(std::move(internal_solid));
-                    ExPolygons internal = diff_ex(
-                        to_polygons(backup.filter_by_type(stInternal)),
-                        polygons_internal,
-                        true);
-                    // assign resulting internal surfaces to layer
-                    neighbor_layerm->fill_surfaces.append(internal, stInternal);
-                    polygons_append(polygons_internal, to_polygons(std::move(internal)));
-                    // assign top and bottom surfaces to layer
-                    SurfaceType surface_types_solid[] = { stTop, stBottom, stBottomBridge };
-                    backup.keep_types(surface_types_solid, 3);
-                    std::vector<SurfacesPtr> top_bottom_groups;
-                    backup.group(&top_bottom_groups);
-                    for (SurfacesPtr &group : top_bottom_groups)
-                        neighbor_layerm->fill_surfaces.append(
-                            diff_ex(to_polygons(group), polygons_internal),
-                            // Use an existing surface as a template, it carries the bridge angle etc.
-                            *group.front());
                 }
-		EXTERNAL:;
-            } // foreach type (stTop, stBottom, stBottomBridge)
-        } // for each layer
-    } // for each region
-
-#ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-    for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
-        for (const Layer *layer : m_layers) {
-            const LayerRegion *layerm = layer->m_regions[region_id];
-            layerm->export_region_slices_to_svg_debug("5_discover_horizontal_shells");
-            layerm->export_region_fill_surfaces_to_svg_debug("5_discover_horizontal_shells");
-        } // for each layer
-    } // for each region
-#endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+                
+                // internal-solid are the union of the existing internal-solid surfaces
+                // and new ones
+                SurfaceCollection backup = std::move(neighbor_layerm->fill_surfaces);
+                polygons_append(new_internal_solid, to_polygons(backup.filter_by_type(stInternalSolid)));
+                ExPolygons internal_solid = union_ex(new_internal_solid, false);
+                // assign new internal-solid surfaces to layer
+                neighbor_layerm->fill_surfaces.set(internal_solid, stInternalSolid);
+                // subtract intersections from layer surfaces to get resulting internal surfaces
+                Polygons polygons_internal = to_polygons(std::move(internal_solid));
+                ExPolygons internal = diff_ex(
+                    to_polygons(backup.filter_by_type(stInternal)),
+                    polygons_internal,
+                    true);
+                // assign resulting internal surfaces to layer
+                neighbor_layerm->fill_surfaces.append(internal, stInternal);
+                polygons_append(polygons_internal, to_polygons(std::move(internal)));
+                // assign top and bottom surfaces to layer
+                SurfaceType surface_types_solid[] = { stTop, stBottom, stBottomBridge };
+                backup.keep_types(surface_types_solid, 3);
+                std::vector<SurfacesPtr> top_bottom_groups;
+                backup.group(&top_bottom_groups);
+                for (SurfacesPtr &group : top_bottom_groups)
+                    neighbor_layerm->fill_surfaces.append(
+                        diff_ex(to_polygons(group), polygons_internal),
+                        // Use an existing surface as a template, it carries the bridge angle etc.
+                        *group.front());
+            }
+	EXTERNAL:;
+        } // foreach type (stTop, stBottom, stBottomBridge)
+    } // for each layer
 }
 
 // combine fill surfaces across layers to honor the "infill every N layers" option
@@ -2359,72 +2836,83 @@ void PrintObject::combine_infill()
             combine[m_layers.size() - 1] = num_layers;
         }
         
-        // loop through layers to which we have assigned layers to combine
-        for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx) {
-            m_print->throw_if_canceled();
-            size_t num_layers = combine[layer_idx];
-			if (num_layers <= 1)
-                continue;
-            // Get all the LayerRegion objects to be combined.
-            std::vector<LayerRegion*> layerms;
-            layerms.reserve(num_layers);
-			for (size_t i = layer_idx + 1 - num_layers; i <= layer_idx; ++ i)
-                layerms.emplace_back(m_layers[i]->regions()[region_id]);
-            // We need to perform a multi-layer intersection, so let's split it in pairs.
-            // Initialize the intersection with the candidates of the lowest layer.
-            ExPolygons intersection = to_expolygons(layerms.front()->fill_surfaces.filter_by_type(stInternal));
-            // Start looping from the second layer and intersect the current intersection with it.
-            for (size_t i = 1; i < layerms.size(); ++ i)
-                intersection = intersection_ex(
-                    to_polygons(intersection),
-                    to_polygons(layerms[i]->fill_surfaces.filter_by_type(stInternal)),
-                    false);
-            double area_threshold = layerms.front()->infill_area_threshold();
-            if (! intersection.empty() && area_threshold > 0.)
-                intersection.erase(std::remove_if(intersection.begin(), intersection.end(), 
-                    [area_threshold](const ExPolygon &expoly) { return expoly.area() <= area_threshold; }), 
-                    intersection.end());
-            if (intersection.empty())
-                continue;
-//            Slic3r::debugf "  combining %d %s regions from layers %d-%d\n",
-//                scalar(@$intersection),
-//                ($type == S_TYPE_INTERNAL ? 'internal' : 'internal-solid'),
-//                $layer_idx-($every-1), $layer_idx;
-            // intersection now contains the regions that can be combined across the full amount of layers,
-            // so let's remove those areas from all layers.
-            Polygons intersection_with_clearance;
-            intersection_with_clearance.reserve(intersection.size());
-            float clearance_offset = 
-                0.5f * layerms.back()->flow(frPerimeter).scaled_width() +
-             // Because fill areas for rectilinear and honeycomb are grown 
-             // later to overlap perimeters, we need to counteract that too.
-                ((region->config().fill_pattern == ipRectilinear   ||
-                  region->config().fill_pattern == ipGrid          ||
-                  region->config().fill_pattern == ipLine          ||
-                  region->config().fill_pattern == ipHoneycomb) ? 1.5f : 0.5f) * 
-                    layerms.back()->flow(frSolidInfill).scaled_width();
-            for (ExPolygon &expoly : intersection)
-                polygons_append(intersection_with_clearance, offset(expoly, clearance_offset));
-            for (LayerRegion *layerm : layerms) {
-                Polygons internal = to_polygons(layerm->fill_surfaces.filter_by_type(stInternal));
-                layerm->fill_surfaces.remove_type(stInternal);
-                layerm->fill_surfaces.append(diff_ex(internal, intersection_with_clearance, false), stInternal);
-                if (layerm == layerms.back()) {
-                    // Apply surfaces back with adjusted depth to the uppermost layer.
-                    Surface templ(stInternal, ExPolygon());
-                    templ.thickness = 0.;
-                    for (LayerRegion *layerm2 : layerms)
-                        templ.thickness += layerm2->layer()->height;
-                    templ.thickness_layers = (unsigned short)layerms.size();
-                    layerm->fill_surfaces.append(intersection, templ);
-                } else {
-                    // Save void surfaces.
-                    layerm->fill_surfaces.append(
-                        intersection_ex(internal, intersection_with_clearance, false),
-                        stInternalVoid);
+        // The layers to which we have assigned layers to combine. The groups of combined layers do not overlap,
+        // therefore they are processed in parallel.
+        std::vector<size_t> combined_layers;
+        for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx)
+            if (combine[layer_idx] > 1)
+                combined_layers.emplace_back(layer_idx);
+        BOOST_LOG_TRIVIAL(debug) << "Combining infill for region " << region_id << " in parallel - start";
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, combined_layers.size()),
+            [this, region, region_id, &combine, &combined_layers](const tbb::blocked_range<size_t>& range) {
+                for (size_t i_combined = range.begin(); i_combined < range.end(); ++ i_combined) {
+                    m_print->throw_if_canceled();
+                    size_t layer_idx  = combined_layers[i_combined];
+                    size_t num_layers = combine[layer_idx];
+                    // Get all the LayerRegion objects to be combined.
+                    std::vector<LayerRegion*> layerms;
+                    layerms.reserve(num_layers);
+                    for (size_t i = layer_idx + 1 - num_layers; i <= layer_idx; ++ i)
+                        layerms.emplace_back(m_layers[i]->regions()[region_id]);
+                    // We need to perform a multi-layer intersection, so let's split it in pairs.
+                    // Initialize the intersection with the candidates of the lowest layer.
+                    ExPolygons intersection = to_expolygons(layerms.front()->fill_surfaces.filter_by_type(stInternal));
+                    // Start looping from the second layer and intersect the current intersection with it.
+                    for (size_t i = 1; i < layerms.size(); ++ i)
+                        intersection = intersection_ex(
+                            to_polygons(intersection),
+                            to_polygons(layerms[i]->fill_surfaces.filter_by_type(stInternal)),
+                            false);
+                    double area_threshold = layerms.front()->infill_area_threshold();
+                    if (! intersection.empty() && area_threshold > 0.)
+                        intersection.erase(std::remove_if(intersection.begin(), intersection.end(), 
+                            [area_threshold](const ExPolygon &expoly) { return expoly.area() <= area_threshold; }), 
+                            intersection.end());
+                    if (intersection.empty())
+                        continue;
+//                    Slic3r::debugf "  combining %d %s regions from layers %d-%d\n",
+//                        scalar(@$intersection),
+//                        ($type == S_TYPE_INTERNAL ? 'internal' : 'internal-solid'),
+//                        $layer_idx-($every-1), $layer_idx;
+                    // intersection now contains the regions that can be combined across the full amount of layers,
+                    // so let's remove those areas from all layers.
+                    Polygons intersection_with_clearance;
+                    intersection_with_clearance.reserve(intersection.size());
+                    float clearance_offset = 
+                        0.5f * layerms.back()->flow(frPerimeter).scaled_width() +
+                     // Because fill areas for rectilinear and honeycomb are grown 
+                     // later to overlap perimeters, we need to counteract that too.
+                        ((region->config().fill_pattern == ipRectilinear   ||
+                          region->config().fill_pattern == ipGrid          ||
+                          region->config().fill_pattern == ipLine          ||
+                          region->config().fill_pattern == ipHoneycomb) ? 1.5f : 0.5f) * 
+                            layerms.back()->flow(frSolidInfill).scaled_width();
+                    for (ExPolygon &expoly : intersection)
+                        polygons_append(intersection_with_clearance, offset(expoly, clearance_offset));
+                    for (LayerRegion *layerm : layerms) {
+                        Polygons internal = to_polygons(layerm->fill_surfaces.filter_by_type(stInternal));
+                        layerm->fill_surfaces.remove_type(stInternal);
+                        layerm->fill_surfaces.append(diff_ex(internal, intersection_with_clearance, false), stInternal);
+                        if (layerm == layerms.back()) {
+                            // Apply surfaces back with adjusted depth to the uppermost layer.
+                            Surface templ(stInternal, ExPolygon());
+                            templ.thickness = 0.;
+                            for (LayerRegion *layerm2 : layerms)
+                                templ.thickness += layerm2->layer()->height;
+                            templ.thickness_layers = (unsigned short)layerms.size();
+                            layerm->fill_surfaces.append(intersection, templ);
+                        } else {
+                            // Save void surfaces.
+                            layerm->fill_surfaces.append(
+                                intersection_ex(internal, intersection_with_clearance, false),
+                                stInternalVoid);
+                        }
+                    }
                 }
-            }
-        }
+            });
+        m_print->throw_if_canceled();
+        BOOST_LOG_TRIVIAL(debug) << "Combining infill for region " << region_id << " in parallel - end";
     }
 }
 
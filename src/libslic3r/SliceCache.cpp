@@ -0,0 +1,232 @@
+#include "SliceCache.hpp"
+#include "TriangleMesh.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/cstdio.hpp>
+#include <boost/uuid/detail/sha1.hpp>
+
+namespace Slic3r {
+
+// Bump the version whenever the file format or the slicing algorithm changes.
+static const char     SLICE_CACHE_MAGIC[8] = { 'S', 'L', 'C', 'A', 'C', 'H', 'E', '1' };
+static const uint32_t SLICE_CACHE_VERSION  = 2;
+// Written in the native byte order, a file written by a machine of a different byte order will not match.
+static const uint32_t SLICE_CACHE_BYTE_ORDER = 0x01020304;
+static const char    *SLICE_CACHE_EXTENSION  = ".slices";
+
+struct SliceCacheHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    // sizeof(coord_t) of the build writing the file.
+    uint32_t coord_size;
+    uint32_t num_layers;
+    // SHA-1 digest of the slicing input in hex, see SliceCache::hash().
+    char     key[40];
+};
+
+std::string SliceCache::hash(const TriangleMesh &mesh, const std::vector<float> &z, float closing_radius)
+{
+    boost::uuids::detail::sha1 sha1;
+    uint32_t num_facets = uint32_t(mesh.stl.stats.number_of_facets);
+    uint32_t num_layers = uint32_t(z.size());
+    sha1.process_bytes(&SLICE_CACHE_VERSION, sizeof(SLICE_CACHE_VERSION));
+    sha1.process_bytes(&num_facets, sizeof(num_facets));
+    for (uint32_t i = 0; i < num_facets; ++ i)
+        sha1.process_bytes(mesh.stl.facet_start[i].vertex, sizeof(stl_vertex) * 3);
+    sha1.process_bytes(&num_layers, sizeof(num_layers));
+    if (! z.empty())
+        sha1.process_bytes(z.data(), sizeof(float) * z.size());
+    sha1.process_bytes(&closing_radius, sizeof(closing_radius));
+    boost::uuids::detail::sha1::digest_type digest;
+    sha1.get_digest(digest);
+    char hex[41];
+    for (int i = 0; i < 5; ++ i)
+        sprintf(hex + 8 * i, "%08x", (unsigned int)digest[i]);
+    return std::string(hex, 40);
+}
+
+std::string SliceCache::path(const std::string &key) const
+{
+    return (boost::filesystem::path(m_dir) / (key + SLICE_CACHE_EXTENSION)).string();
+}
+
+// Sequential reader of a memory mapped cache file, guarding against truncated or corrupted files.
+class SliceCacheReader
+{
+public:
+    SliceCacheReader(const char *begin, const char *end) : m_ptr(begin), m_end(end) {}
+    bool read(void *data, size_t len) {
+        if (size_t(m_end - m_ptr) < len)
+            return false;
+        memcpy(data, m_ptr, len);
+        m_ptr += len;
+        return true;
+    }
+    bool read_points(Points &pts) {
+        uint32_t n;
+        if (! this->read(&n, sizeof(n)) || size_t(m_end - m_ptr) < size_t(n) * 2 * sizeof(coord_t))
+            return false;
+        pts.assign(n, Point());
+        for (Point &pt : pts) {
+            coord_t xy[2];
+            this->read(xy, sizeof(xy));
+            pt = Point(xy[0], xy[1]);
+        }
+        return true;
+    }
+    bool at_end() const { return m_ptr == m_end; }
+
+private:
+    const char *m_ptr;
+    const char *m_end;
+};
+
+bool SliceCache::load(const std::string &key, size_t num_layers, std::vector<ExPolygons> &layers) const
+{
+    std::string file_path = this->path(key);
+    boost::system::error_code ec;
+    if (! boost::filesystem::exists(file_path, ec))
+        return false;
+    try {
+        boost::interprocess::file_mapping  mapping(file_path.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(mapping, boost::interprocess::read_only);
+        const char *begin = static_cast<const char*>(region.get_address());
+        SliceCacheReader reader(begin, begin + region.get_size());
+        SliceCacheHeader header;
+        if (! reader.read(&header, sizeof(header)) ||
+            memcmp(header.magic, SLICE_CACHE_MAGIC, sizeof(SLICE_CACHE_MAGIC)) != 0 ||
+            header.version != SLICE_CACHE_VERSION || header.byte_order != SLICE_CACHE_BYTE_ORDER || 
+            header.coord_size != sizeof(coord_t) || header.num_layers != num_layers ||
+            key.size() != sizeof(header.key) || memcmp(header.key, key.data(), sizeof(header.key)) != 0)
+            throw std::runtime_error("Invalid header");
+        layers.assign(num_layers, ExPolygons());
+        for (ExPolygons &expolygons : layers) {
+            uint32_t num_expolygons;
+            if (! reader.read(&num_expolygons, sizeof(num_expolygons)))
+                throw std::runtime_error("Truncated file");
+            expolygons.assign(num_expolygons, ExPolygon());
+            for (ExPolygon &expoly : expolygons) {
+                uint32_t num_holes;
+                if (! reader.read(&num_holes, sizeof(num_holes)) || ! reader.read_points(expoly.contour.points))
+                    throw std::runtime_error("Truncated file");
+                expoly.holes.assign(num_holes, Polygon());
+                for (Polygon &hole : expoly.holes)
+                    if (! reader.read_points(hole.points))
+                        throw std::runtime_error("Truncated file");
+            }
+        }
+        if (! reader.at_end())
+            throw std::runtime_error("Trailing data");
+    } catch (const std::exception &ex) {
+        BOOST_LOG_TRIVIAL(warning) << "Slice cache: Ignoring " << file_path << ": " << ex.what();
+        layers.clear();
+        return false;
+    }
+    // Mark the file as recently used for limit_size().
+    boost::filesystem::last_write_time(file_path, std::time(nullptr), ec);
+    return true;
+}
+
+static inline void write_points(FILE *f, const Points &pts)
+{
+    uint32_t n = uint32_t(pts.size());
+    fwrite(&n, sizeof(n), 1, f);
+    for (const Point &pt : pts) {
+        coord_t xy[2] = { pt(0), pt(1) };
+        fwrite(xy, sizeof(xy), 1, f);
+    }
+}
+
+void SliceCache::store(const std::string &key, const std::vector<ExPolygons> &layers) const
+{
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(m_dir, ec);
+    std::string file_path = this->path(key);
+    std::string tmp_path  = file_path + "." + boost::filesystem::unique_path().string();
+    FILE *f = boost::nowide::fopen(tmp_path.c_str(), "wb");
+    if (f == nullptr) {
+        BOOST_LOG_TRIVIAL(warning) << "Slice cache: Cannot create " << tmp_path;
+        return;
+    }
+    SliceCacheHeader header;
+    memcpy(header.magic, SLICE_CACHE_MAGIC, sizeof(SLICE_CACHE_MAGIC));
+    header.version    = SLICE_CACHE_VERSION;
+    header.byte_order = SLICE_CACHE_BYTE_ORDER;
+    header.coord_size = uint32_t(sizeof(coord_t));
+    header.num_layers = uint32_t(layers.size());
+    assert(key.size() == sizeof(header.key));
+    memcpy(header.key, key.data(), sizeof(header.key));
+    fwrite(&header, sizeof(header), 1, f);
+    for (const ExPolygons &expolygons : layers) {
+        uint32_t num_expolygons = uint32_t(expolygons.size());
+        fwrite(&num_expolygons, sizeof(num_expolygons), 1, f);
+        for (const ExPolygon &expoly : expolygons) {
+            uint32_t num_holes = uint32_t(expoly.holes.size());
+            fwrite(&num_holes, sizeof(num_holes), 1, f);
+            write_points(f, expoly.contour.points);
+            for (const Polygon &hole : expoly.holes)
+                write_points(f, hole.points);
+        }
+    }
+    bool failed = ferror(f) != 0;
+    if (fclose(f) != 0)
+        failed = true;
+    if (! failed)
+        boost::filesystem::rename(tmp_path, file_path, ec);
+    if (failed || ec) {
+        BOOST_LOG_TRIVIAL(warning) << "Slice cache: Failed to write " << file_path;
+        boost::filesystem::remove(tmp_path, ec);
+    } else if (m_size_limit > 0)
+        this->limit_size();
+}
+
+// Delete the least recently used cache files until the cache fits into the size limit.
+// The most recently used file is always kept.
+void SliceCache::limit_size() const
+{
+    struct CacheFile {
+        boost::filesystem::path path;
+        std::time_t             time;
+        uintmax_t               size;
+    };
+    std::vector<CacheFile> files;
+    uintmax_t              total_size = 0;
+    boost::system::error_code ec;
+    for (boost::filesystem::directory_iterator it(m_dir, ec), end; ! ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != SLICE_CACHE_EXTENSION)
+            continue;
+        boost::system::error_code ec_file;
+        CacheFile file;
+        file.path = it->path();
+        file.time = boost::filesystem::last_write_time(file.path, ec_file);
+        if (! ec_file)
+            file.size = boost::filesystem::file_size(file.path, ec_file);
+        if (! ec_file) {
+            total_size += file.size;
+            files.emplace_back(std::move(file));
+        }
+    }
+    if (total_size <= m_size_limit)
+        return;
+    std::sort(files.begin(), files.end(), [](const CacheFile &f1, const CacheFile &f2) { return f1.time < f2.time; });
+    size_t num_removed = 0;
+    for (; num_removed + 1 < files.size() && total_size > m_size_limit; ++ num_removed) {
+        // The file may have been deleted by a concurrently running process.
+        boost::filesystem::remove(files[num_removed].path, ec);
+        total_size -= files[num_removed].size;
+    }
+    if (num_removed > 0)
+        BOOST_LOG_TRIVIAL(debug) << "Slice cache: Deleted " << num_removed << " least recently used files, " << total_size << " bytes left";
+}
+
+} // namespace Slic3r
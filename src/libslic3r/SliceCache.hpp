@@ -0,0 +1,50 @@
+#ifndef slic3r_SliceCache_hpp_
+#define slic3r_SliceCache_hpp_
+
+#include <string>
+#include <vector>
+
+#include "libslic3r.h"
+#include "ExPolygon.hpp"
+
+namespace Slic3r {
+
+class TriangleMesh;
+
+// Persistent on-disk cache of mesh slices.
+// The slices are stored in a compact binary file named after a SHA-1 digest of the slicing input
+// (the transformed mesh, the slicing planes and the slice closing radius), therefore
+// the cache does not need to be invalidated and it may be shared by multiple processes.
+// The cache files record the byte order and the coordinate size of the build writing them,
+// files written by an incompatible build are ignored.
+class SliceCache
+{
+public:
+    // Caching is disabled if dir is empty. If size_limit is not zero, the least recently used files
+    // are deleted after storing new slices into the cache, until the cache fits into size_limit bytes.
+    explicit SliceCache(const std::string &dir, size_t size_limit = 0) : m_dir(dir), m_size_limit(size_limit) {}
+
+    bool        enabled() const { return ! m_dir.empty(); }
+
+    // SHA-1 digest of the input of TriangleMeshSlicer::slice(), in hex.
+    static std::string hash(const TriangleMesh &mesh, const std::vector<float> &z, float closing_radius);
+
+    // Load the slices from a memory mapped cache file.
+    // Returns false if the file does not exist or if it is not valid.
+    bool        load(const std::string &key, size_t num_layers, std::vector<ExPolygons> &layers) const;
+    // Store the slices into the cache. The file is written under a temporary name first and then renamed,
+    // so that a concurrently running process never sees a partially written file.
+    // Failing to write the cache is not an error, the slices will just be calculated again the next time.
+    void        store(const std::string &key, const std::vector<ExPolygons> &layers) const;
+
+private:
+    std::string path(const std::string &key) const;
+    void        limit_size() const;
+
+    std::string m_dir;
+    size_t      m_size_limit;
+};
+
+} // namespace Slic3r
+
+#endif /* slic3r_SliceCache_hpp_ */
@@ -14,7 +14,7 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/atomic.h>
-#include <tbb/spin_mutex.h>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/task_group.h>
 
 // #define SLIC3R_DEBUG
@@ -184,27 +184,33 @@ PrintObjectSupportMaterial::PrintObjectSupportMaterial(const PrintObject *object
     }
 }
 
-// Using the std::deque as an allocator.
 inline PrintObjectSupportMaterial::MyLayer& layer_allocate(
-    std::deque<PrintObjectSupportMaterial::MyLayer> &layer_storage, 
+    PrintObjectSupportMaterial::MyLayerStorage      &layer_storage, 
     PrintObjectSupportMaterial::SupporLayerType      layer_type)
 { 
-    layer_storage.push_back(PrintObjectSupportMaterial::MyLayer());
-    layer_storage.back().layer_type = layer_type;
-    return layer_storage.back();
+    return layer_storage.allocate(layer_type);
 }
 
+// Thread local layer storages of a parallel section.
+typedef tbb::enumerable_thread_specific<std::deque<PrintObjectSupportMaterial::MyLayer>> MyLayerStorageTLS;
+
+// Using the thread local std::deque as an allocator.
 inline PrintObjectSupportMaterial::MyLayer& layer_allocate(
-    std::deque<PrintObjectSupportMaterial::MyLayer> &layer_storage,
-    tbb::spin_mutex                                 &layer_storage_mutex,
+    MyLayerStorageTLS                               &layer_storage_tls,
     PrintObjectSupportMaterial::SupporLayerType      layer_type)
 { 
-    layer_storage_mutex.lock();
-    layer_storage.push_back(PrintObjectSupportMaterial::MyLayer());
-    PrintObjectSupportMaterial::MyLayer *layer_new = &layer_storage.back();
-    layer_storage_mutex.unlock();
-    layer_new->layer_type = layer_type;
-    return *layer_new;
+    std::deque<PrintObjectSupportMaterial::MyLayer> &layer_storage = layer_storage_tls.local();
+    layer_storage.emplace_back();
+    layer_storage.back().layer_type = layer_type;
+    return layer_storage.back();
+}
+
+// Pass the ownership of the layers allocated by a parallel section to the layer storage.
+inline void layer_storage_adopt(PrintObjectSupportMaterial::MyLayerStorage &layer_storage, MyLayerStorageTLS &layer_storage_tls)
+{
+    for (std::deque<PrintObjectSupportMaterial::MyLayer> &layers : layer_storage_tls)
+        if (! layers.empty())
+            layer_storage.adopt(layers);
 }
 
 inline void layers_append(PrintObjectSupportMaterial::MyLayersPtr &dst, const PrintObjectSupportMaterial::MyLayersPtr &src)
@@ -1013,9 +1019,9 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
     // For each overhang layer, two supporting layers may be generated: One for the overhangs extruded with a bridging flow, 
     // and the other for the overhangs extruded with a normal flow.
     contact_out.assign(num_layers * 2, nullptr);
-    tbb::spin_mutex layer_storage_mutex;
+    MyLayerStorageTLS layer_storage_tls;
     tbb::parallel_for(tbb::blocked_range<size_t>(this->has_raft() ? 0 : 1, num_layers),
-        [this, &object, &buildplate_covered, &enforcers, &blockers, support_auto, threshold_rad, &layer_storage, &layer_storage_mutex, &contact_out]
+        [this, &object, &buildplate_covered, &enforcers, &blockers, support_auto, threshold_rad, &layer_storage_tls, &contact_out]
         (const tbb::blocked_range<size_t>& range) {
             for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) 
             {
@@ -1191,7 +1197,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
                 
                 // Now apply the contact areas to the layer where they need to be made.
                 if (! contact_polygons.empty()) {
-                    MyLayer     &new_layer = layer_allocate(layer_storage, layer_storage_mutex, sltTopContact);
+                    MyLayer     &new_layer = layer_allocate(layer_storage_tls, sltTopContact);
                     new_layer.idx_object_layer_above = layer_id;
                     MyLayer     *bridging_layer = nullptr;
                     if (layer_id == 0) {
@@ -1243,7 +1249,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
                                 }
                                 if (bridging_print_z < new_layer.print_z - EPSILON) {
                                     // Allocate the new layer.
-                                    bridging_layer = &layer_allocate(layer_storage, layer_storage_mutex, sltTopContact);
+                                    bridging_layer = &layer_allocate(layer_storage_tls, sltTopContact);
                                     bridging_layer->idx_object_layer_above = layer_id;
                                     bridging_layer->print_z = bridging_print_z;
                                     if (bridging_print_z == m_slicing_params.first_print_layer_height) {
@@ -1342,6 +1348,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
                 }
             }
         });
+    layer_storage_adopt(layer_storage, layer_storage_tls);
 
     // Compress contact_out, remove the nullptr items.
     remove_nulls(contact_out);
@@ -2241,9 +2248,9 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::generate_int
         // For all intermediate layers, collect top contact surfaces, which are not further than support_material_interface_layers.
         BOOST_LOG_TRIVIAL(debug) << "PrintObjectSupportMaterial::generate_interface_layers() in parallel - start";
         interface_layers.assign(intermediate_layers.size(), nullptr);
-        tbb::spin_mutex layer_storage_mutex;
+        MyLayerStorageTLS layer_storage_tls;
         tbb::parallel_for(tbb::blocked_range<size_t>(0, intermediate_layers.size()),
-            [this, &bottom_contacts, &top_contacts, &intermediate_layers, &layer_storage, &layer_storage_mutex, &interface_layers](const tbb::blocked_range<size_t>& range) {
+            [this, &bottom_contacts, &top_contacts, &intermediate_layers, &layer_storage_tls, &interface_layers](const tbb::blocked_range<size_t>& range) {
                 // Index of the first top contact layer intersecting the current intermediate layer.
                 size_t idx_top_contact_first = size_t(-1);
                 // Index of the first bottom contact layer intersecting the current intermediate layer.
@@ -2279,7 +2286,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::generate_int
                         continue;
 
                     // Insert a new layer into top_interface_layers.
-                    MyLayer &layer_new = layer_allocate(layer_storage, layer_storage_mutex,
+                    MyLayer &layer_new = layer_allocate(layer_storage_tls,
                         polygons_top_contact_projected.empty() ? sltBottomInterface : sltTopInterface);
                     layer_new.print_z    = intermediate_layer.print_z;
                     layer_new.bottom_z   = intermediate_layer.bottom_z;
@@ -2295,6 +2302,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::generate_int
                     intermediate_layer.polygons = diff(intermediate_layer.polygons, polygons_top_contact_projected, false);
                 }
             });
+        layer_storage_adopt(layer_storage, layer_storage_tls);
 
         // Compress contact_out, remove the nullptr items.
         remove_nulls(interface_layers);
@@ -139,10 +139,28 @@ public:
     	Polygons *overhang_polygons;
 	};
 
-	// Layers are allocated and owned by a deque. Once a layer is allocated, it is maintained
-	// up to the end of a generate() method. The layer storage may be replaced by an allocator class in the future, 
-	// which would allocate layers by multiple chunks.
-	typedef std::deque<MyLayer> 				MyLayerStorage;
+	// Layers are allocated and owned by deques. Once a layer is allocated, it is maintained
+	// up to the end of a generate() method. A deque does not move its items when growing at its end,
+	// therefore the MyLayersPtr referencing the layers stay valid.
+	// The parallel sections allocate their layers from thread local deques without locking,
+	// which are adopted by the MyLayerStorage at the end of the parallel section.
+	class MyLayerStorage
+	{
+	public:
+		MyLayer& allocate(SupporLayerType layer_type) {
+			m_layers.emplace_back();
+			m_layers.back().layer_type = layer_type;
+			return m_layers.back();
+		}
+		// Take over the layers of a thread local deque without moving the layers in memory.
+		void adopt(std::deque<MyLayer> &layers) {
+			m_adopted.emplace_back();
+			m_adopted.back().swap(layers);
+		}
+	private:
+		std::deque<MyLayer> 					m_layers;
+		std::deque<std::deque<MyLayer>> 		m_adopted;
+	};
 	typedef std::vector<MyLayer*> 				MyLayersPtr;
 
 public:
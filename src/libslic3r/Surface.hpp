@@ -54,16 +54,16 @@ public:
             thickness(other.thickness), thickness_layers(other.thickness_layers), 
             bridge_angle(other.bridge_angle), extra_perimeters(other.extra_perimeters)
         {};
-    Surface(Surface &&rhs)
+    Surface(Surface &&rhs) noexcept
         : surface_type(rhs.surface_type), expolygon(std::move(rhs.expolygon)),
             thickness(rhs.thickness), thickness_layers(rhs.thickness_layers), 
             bridge_angle(rhs.bridge_angle), extra_perimeters(rhs.extra_perimeters)
         {};
-    Surface(SurfaceType _surface_type, const ExPolygon &&_expolygon)
+    Surface(SurfaceType _surface_type, ExPolygon &&_expolygon)
         : surface_type(_surface_type), expolygon(std::move(_expolygon)),
             thickness(-1), thickness_layers(1), bridge_angle(-1), extra_perimeters(0)
         {};
-    Surface(const Surface &other, const ExPolygon &&_expolygon)
+    Surface(const Surface &other, ExPolygon &&_expolygon)
         : surface_type(other.surface_type), expolygon(std::move(_expolygon)),
             thickness(other.thickness), thickness_layers(other.thickness_layers), 
             bridge_angle(other.bridge_angle), extra_perimeters(other.extra_perimeters)
@@ -80,7 +80,7 @@ public:
         return *this;
     }
 
-    Surface& operator=(Surface &&rhs)
+    Surface& operator=(Surface &&rhs) noexcept
     {
         surface_type     = rhs.surface_type;
         expolygon        = std::move(rhs.expolygon);
@@ -149,8 +149,8 @@ inline ExPolygons to_expolygons(Surfaces &&src)
 {
 	ExPolygons expolygons;
 	expolygons.reserve(src.size());
-	for (Surfaces::const_iterator it = src.begin(); it != src.end(); ++it)
-		expolygons.emplace_back(ExPolygon(std::move(it->expolygon)));
+	for (Surfaces::iterator it = src.begin(); it != src.end(); ++it)
+		expolygons.emplace_back(std::move(it->expolygon));
 	src.clear();
 	return expolygons;
 }
@@ -230,7 +230,7 @@ inline void surfaces_append(Surfaces &dst, const ExPolygons &src, SurfaceType su
 }
 inline void surfaces_append(Surfaces &dst, const ExPolygons &src, const Surface &surfaceTempl) 
 { 
-    dst.reserve(dst.size() + number_polygons(src));
+    dst.reserve(dst.size() + src.size());
     for (const ExPolygon &expoly : src)
         dst.emplace_back(Surface(surfaceTempl, expoly));
 }
@@ -249,8 +249,8 @@ inline void surfaces_append(Surfaces &dst, ExPolygons &&src, SurfaceType surface
 
 inline void surfaces_append(Surfaces &dst, ExPolygons &&src, const Surface &surfaceTempl) 
 { 
-    dst.reserve(dst.size() + number_polygons(src));
-    for (ExPolygons::const_iterator it = src.begin(); it != src.end(); ++ it)
+    dst.reserve(dst.size() + src.size());
+    for (ExPolygons::iterator it = src.begin(); it != src.end(); ++ it)
         dst.emplace_back(Surface(surfaceTempl, std::move(*it)));
     src.clear();
 }
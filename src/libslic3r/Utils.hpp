@@ -20,6 +20,10 @@ extern std::string format_memsize_MB(size_t n);
 // Return string to be added to the boost::log output to inform about the current process memory allocation.
 // The string is non-empty only if the loglevel >= info (3).
 extern std::string log_memory_info();
+// Peak resident memory of the process in bytes, zero if not available.
+extern size_t get_peak_rss();
+// User and system CPU time consumed by all the threads of the process in seconds.
+extern double get_cpu_time();
 extern void disable_multi_threading();
 
 // Set a path with GUI resource files.
@@ -11,6 +11,7 @@
 #include <psapi.h>
 #else
 #include <unistd.h>
+#include <sys/resource.h>
 #endif
 
 #include <boost/log/core.hpp>
@@ -460,10 +461,54 @@ std::string log_memory_info()
     return out;
 }
 
+size_t get_peak_rss()
+{
+    PROCESS_MEMORY_COUNTERS pmc;
+    return GetProcessMemoryInfo(::GetCurrentProcess(), &pmc, sizeof(pmc)) ? size_t(pmc.PeakWorkingSetSize) : 0;
+}
+
+double get_cpu_time()
+{
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (! GetProcessTimes(::GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+        return 0.;
+    // FILETIME is in 100ns units.
+    auto seconds = [](const FILETIME &t) { return 1e-7 * double((uint64_t(t.dwHighDateTime) << 32) | uint64_t(t.dwLowDateTime)); };
+    return seconds(kernel_time) + seconds(user_time);
+}
+
 #else
 std::string log_memory_info()
 {
-    return std::string();
+    std::string out;
+    if (logSeverity <= boost::log::trivial::info) {
+        size_t peak_rss = get_peak_rss();
+        if (peak_rss > 0)
+            out = " PeakRSS: " + format_memsize_MB(peak_rss);
+    }
+    return out;
+}
+
+size_t get_peak_rss()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    // Bytes on OSX.
+    return size_t(usage.ru_maxrss);
+#else
+    // Kilobytes on Linux.
+    return size_t(usage.ru_maxrss) * 1024;
+#endif
+}
+
+double get_cpu_time()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0.;
+    return double(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + 1e-6 * double(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
 }
 #endif
 
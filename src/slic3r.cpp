@@ -20,6 +20,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/nowide/args.hpp>
 #include <boost/nowide/cenv.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <boost/nowide/iostream.hpp>
 
 #include "unix/fhs.hpp"  // Generated by CMake from ../platform/unix/fhs.hpp.in
@@ -398,6 +399,16 @@ int CLI::run(int argc, char **argv)
                             return 1;
                         }
                         boost::nowide::cout << "Slicing result exported to " << outfile << std::endl;
+                        if (printer_technology == ptFFF && m_config.has("statistics")) {
+                            const std::string &statistics_path = m_config.opt_string("statistics");
+                            boost::nowide::ofstream file(statistics_path);
+                            file << fff_print.step_statistics_json();
+                            file.close();
+                            if (file.fail()) {
+                                boost::nowide::cerr << "Writing the step statistics to " << statistics_path << " failed" << std::endl;
+                                return 1;
+                            }
+                        }
                     } catch (const std::exception &ex) {
 						boost::nowide::cerr << ex.what() << std::endl;
                         return 1;                        
@@ -44,7 +44,9 @@ public:
 	// Stop the background processing and finalize the bacgkround processing thread, remove temp files.
 	~BackgroundSlicingProcess();
 
-	void set_fff_print(Print *print) { m_fff_print = print; }
+	// The G-code preview reads the extrusions of the print objects on the UI thread while the G-code is being exported,
+	// therefore the low memory mode shall not release them.
+	void set_fff_print(Print *print) { m_fff_print = print; m_fff_print->set_keep_extrusions(true); }
 	void set_sla_print(SLAPrint *print) { m_sla_print = print; }
 	void set_gcode_preview_data(GCodePreviewData *gpd) { m_gcode_preview_data = gpd; }
 	// The following wxCommandEvent will be sent to the UI thread / Platter window, when the slicing is finished
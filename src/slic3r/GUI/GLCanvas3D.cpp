@@ -6153,10 +6153,12 @@ void GLCanvas3D::_load_shells_fff()
         return;
 
     // adds objects' volumes 
+    // Iterate over the ModelObjects, as multiple identical ModelObjects may be printed by a single PrintObject.
     int object_id = 0;
-    for (const PrintObject* obj : print->objects())
+    for (const ModelObject* model_obj : print->model().objects)
     {
-        const ModelObject* model_obj = obj->model_object();
+        if (std::none_of(model_obj->instances.begin(), model_obj->instances.end(), [](const ModelInstance *inst){ return inst->is_printable(); }))
+            continue;
 
         std::vector<int> instance_ids(model_obj->instances.size());
         for (int i = 0; i < (int)model_obj->instances.size(); ++i)
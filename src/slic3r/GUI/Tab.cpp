@@ -1100,6 +1100,7 @@ void TabPrint::build()
 
 		optgroup = page->new_optgroup(_(L("Advanced")));
 		optgroup->append_single_option_line("interface_shells");
+		optgroup->append_single_option_line("layer_wavefront");
 
 	page = add_options_page(_(L("Advanced")), "wrench.png");
 		optgroup = page->new_optgroup(_(L("Extrusion width")));
@@ -1126,6 +1127,9 @@ void TabPrint::build()
 
 		optgroup = page->new_optgroup(_(L("Other")));
 		optgroup->append_single_option_line("clip_multipart_objects");
+		optgroup->append_single_option_line("low_memory");
+		optgroup->append_single_option_line("slice_cache");
+		optgroup->append_single_option_line("slice_cache_size");
 
 	page = add_options_page(_(L("Output options")), "page_white_go.png");
 		optgroup = page->new_optgroup(_(L("Sequential printing")));
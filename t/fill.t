@@ -4,7 +4,7 @@ use warnings;
 
 #plan tests => 43;
 # Test of a 100% coverage is off.
-plan tests => 19;
+plan tests => 23;
 
 BEGIN {
     use FindBin;
@@ -315,4 +315,30 @@ for my $pattern (qw(rectilinear honeycomb hilbertcurve concentric)) {
     is scalar(@$diff), 0, 'no missing parts in solid shell when fill_density is 0';
 }
 
+{
+    # The layers of a prismatic object repeat the infill of the layer one infill pattern period below,
+    # which is copied instead of being generated again. Compare with the infill generated for each layer.
+    my $fills = sub {
+        my ($object) = @_;
+        return [ map { my $layerm = $_; [ $layerm->fills->count,
+            map [ $_->role, $_->mm3_per_mm, $_->width, $_->height, $_->pp ], @{$layerm->fills->flatten} ] }
+            map @{$_->regions}, @{$object->layers} ];
+    };
+    for my $pattern (qw(rectilinear honeycomb)) {
+        for my $infill_every_layers (1, 2) {
+            my $config = Slic3r::Config::new_from_defaults;
+            $config->set('fill_pattern', $pattern);
+            $config->set('fill_density', 0.2);
+            $config->set('infill_every_layers', $infill_every_layers);
+            my $print = Slic3r::Test::init_print('20mm_cube', config => $config, scale_xyz => [1,1,3]);
+            Slic3r::Test::gcode($print);
+            my $object = $print->print->objects->[0];
+            my $copied = $fills->($object);
+            $_->make_fills for @{$object->layers};
+            is_deeply $copied, $fills->($object),
+                "repeated $pattern infill equals the infill generated per layer, infill_every_layers = $infill_every_layers";
+        }
+    }
+}
+
 __END__
@@ -1,4 +1,4 @@
-use Test::More tests => 59;
+use Test::More tests => 62;
 use strict;
 use warnings;
 
@@ -441,4 +441,19 @@ use Slic3r::Test;
     $test->('small_dorito');
 }
 
+{
+    # Layer wavefront processing changes the order in which the layers are processed, not the result.
+    # The config dump at the end of the G-code differs in layer_wavefront, therefore only compare the commands.
+    my $gcode = sub {
+        my ($model_name, $layer_wavefront) = @_;
+        my $config = Slic3r::Config::new_from_defaults;
+        $config->set('layer_wavefront', $layer_wavefront);
+        $config->set('fill_density', 0.2);
+        my $print = Slic3r::Test::init_print($model_name, config => $config);
+        return join "\n", grep !/^;/, split /\n/, Slic3r::Test::gcode($print);
+    };
+    ok $gcode->($_, 0) eq $gcode->($_, 1), "layer_wavefront generates the same G-code for $_"
+        for qw(20mm_cube V overhang);
+}
+
 __END__
@@ -1,4 +1,4 @@
-use Test::More tests => 6;
+use Test::More tests => 20;
 use strict;
 use warnings;
 
@@ -8,7 +8,8 @@ BEGIN {
     use local::lib "$FindBin::Bin/../local-lib";
 }
 
-use List::Util qw(first);
+use File::Temp qw(tempdir);
+use List::Util qw(first sum);
 use Slic3r;
 use Slic3r::Geometry qw(unscale X Y);
 use Slic3r::Test;
@@ -57,4 +58,111 @@ use Slic3r::Test;
     is $print->print->regions->[0]->config->perimeter_extruder, 2, 'extruder setting does not override explicitely specified extruders';
 }
 
+{
+    # Slice a model through Print::apply(), as the GUI does, and return the G-code without the time stamp.
+    my $gcode = sub {
+        my ($print, $model, $config) = @_;
+        $print->apply($model, $config);
+        return join "\n", grep !/^; generated by/, split /\n/, Slic3r::Test::gcode($print);
+    };
+    my $model = Slic3r::Test::model('20mm_cube');
+    $model->center_instances_around_point(Slic3r::Pointf->new(100,100));
+    my $config = Slic3r::Config::new_from_defaults;
+    $config->set('low_memory', 1);
+    $config->set('fill_density', 30);
+    $config->set('fill_pattern', 'rectilinear');
+    
+    # The low memory mode releases the fill surfaces after the object was processed.
+    my $print = Slic3r::Print->new;
+    $gcode->($print, $model, $config);
+    # Changing the infill pattern only of the region shall still refill all the layers.
+    $config->set('fill_pattern', 'honeycomb');
+    my $gcode_changed = $gcode->($print, $model, $config);
+    my $gcode_fresh   = $gcode->(Slic3r::Print->new, $model, $config);
+    ok $gcode_changed eq $gcode_fresh, 'fill_pattern change after the low memory mode released the fill surfaces regenerates the infill';
+}
+
+{
+    # The low memory mode releases the exported extrusions, unless they are kept for the G-code preview, as the GUI does.
+    my $num_extrusions = sub {
+        my ($keep_extrusions) = @_;
+        my $config = Slic3r::Config::new_from_defaults;
+        $config->set('low_memory', 1);
+        my $print = Slic3r::Test::init_print('20mm_cube', config => $config);
+        $print->print->set_keep_extrusions($keep_extrusions);
+        Slic3r::Test::gcode($print);
+        return sum(map $_->perimeters->count + $_->fills->count, map @{$_->regions}, @{$print->print->objects->[0]->layers});
+    };
+    is $num_extrusions->(0), 0, 'low memory mode releases the exported extrusions';
+    ok $num_extrusions->(1) > 0, 'low memory mode keeps the exported extrusions for the G-code preview';
+}
+
+{
+    # Identical ModelObjects are folded into a single PrintObject with multiple copies.
+    my $model = Slic3r::Test::model('20mm_cube');
+    $model->add_object($model->objects->[0]);
+    $model->arrange_objects(5);
+    my $config = Slic3r::Config::new_from_defaults;
+    my $print = Slic3r::Print->new;
+    $print->apply($model, $config);
+    is $print->object_count, 1, 'identical objects are printed by a single PrintObject';
+    is scalar(@{$print->get_object(0)->copies}), 2, 'the PrintObject prints the copies of both objects';
+    # Modifying one of the objects splits it out again.
+    $model->objects->[1]->config->set('perimeters', 5);
+    $print->apply($model, $config);
+    is $print->object_count, 2, 'a modified object is printed by its own PrintObject';
+    is_deeply [ map scalar(@{$_->copies}), @{$print->objects} ], [ 1, 1 ], 'each PrintObject prints a single copy';
+}
+
+{
+    # Slices stored into the slice cache are loaded back by the next run, corrupted cache files are ignored.
+    my $cache_dir = tempdir(CLEANUP => 1);
+    my $gcode = sub {
+        my ($slice_cache) = @_;
+        my $config = Slic3r::Config::new_from_defaults;
+        $config->set('slice_cache', $slice_cache);
+        my $print = Slic3r::Test::init_print('20mm_cube', config => $config);
+        return join "\n", grep !/^; (generated by|slice_cache)/, split /\n/, Slic3r::Test::gcode($print);
+    };
+    my $gcode_uncached = $gcode->('');
+    ok $gcode->($cache_dir) eq $gcode_uncached, 'G-code with slices stored into the slice cache';
+    my @cache_files = glob("$cache_dir/*.slices");
+    is scalar(@cache_files), 1, 'slices stored into the slice cache';
+    ok $gcode->($cache_dir) eq $gcode_uncached, 'G-code with slices loaded from the slice cache';
+    truncate $cache_files[0], 100;
+    ok $gcode->($cache_dir) eq $gcode_uncached, 'truncated slice cache file is ignored';
+}
+
+{
+    # Changing an infill option of a modifier volume refills just the layers of its region.
+    # The other layers keep their infill, which shall match a fresh slicing of the modified model.
+    my $gcode = sub {
+        my ($print, $model, $config) = @_;
+        $print->apply($model, $config);
+        return join "\n", grep !/^; generated by/, split /\n/, Slic3r::Test::gcode($print);
+    };
+    foreach my $mode ([ 0, 0 ], [ 1, 0 ], [ 1, 1 ]) {
+        my ($low_memory, $keep_extrusions) = @$mode;
+        my $model = Slic3r::Test::model('20mm_cube');
+        my $modifier_mesh = Slic3r::Test::mesh('box', dim => [ 20, 20, 5 ]);
+        $modifier_mesh->translate(0, 0, 5);
+        my $modifier_config = Slic3r::Config->new;
+        $modifier_config->set('fill_pattern', 'concentric');
+        $model->objects->[0]->add_volume(mesh => $modifier_mesh, modifier => 1, config => $modifier_config);
+        $model->center_instances_around_point(Slic3r::Pointf->new(100,100));
+        my $config = Slic3r::Config::new_from_defaults;
+        $config->set('low_memory', $low_memory);
+        $config->set('fill_density', 30);
+        $config->set('fill_pattern', 'rectilinear');
+
+        my $print = Slic3r::Print->new;
+        $print->set_keep_extrusions($keep_extrusions);
+        $gcode->($print, $model, $config);
+        $model->objects->[0]->volumes->[1]->config->set('fill_pattern', 'honeycomb');
+        my $gcode_changed = $gcode->($print, $model, $config);
+        my $gcode_fresh   = $gcode->(Slic3r::Print->new, $model, $config);
+        ok $gcode_changed eq $gcode_fresh, "fill_pattern change of a modifier volume matches a fresh slicing (low_memory $low_memory, keep_extrusions $keep_extrusions)";
+    }
+}
+
 __END__